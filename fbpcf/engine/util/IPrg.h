@@ -9,7 +9,11 @@
 
 #include <assert.h>
 #include <emmintrin.h>
+#include <algorithm>
 #include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
 #include "fbpcf/engine/util/util.h"
 
 namespace fbpcf::engine::util {
@@ -24,6 +28,22 @@ class IPrg {
     return buildM128i(randomBytes);
   }
 
+  // generate many random blocks with as few calls to the prg as possible,
+  // each call draws less than 2^32 bytes.
+  std::vector<__m128i> getRandomM128i(size_t size) {
+    const size_t kMaxBlocksPerCall = UINT32_MAX / sizeof(__m128i);
+    std::vector<__m128i> rst(size);
+    for (size_t i = 0; i < size; i += kMaxBlocksPerCall) {
+      auto count = std::min(kMaxBlocksPerCall, size - i);
+      auto randomBytes = getRandomBytes(count * sizeof(__m128i));
+      if (randomBytes.size() != count * sizeof(__m128i)) {
+        throw std::runtime_error("The prg returned an unexpected size!");
+      }
+      std::memcpy(rst.data() + i, randomBytes.data(), randomBytes.size());
+    }
+    return rst;
+  }
+
   virtual std::vector<bool> getRandomBits(uint32_t size) = 0;
 
   virtual std::vector<unsigned char> getRandomBytes(uint32_t size) = 0;
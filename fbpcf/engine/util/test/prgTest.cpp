@@ -42,6 +42,37 @@ TEST(AesPrgTest, testGetRandomBits) {
   }
 }
 
+TEST(AesPrgTest, testGetRandomM128iBatch) {
+  AesPrg prg1(_mm_set_epi32(1, 2, 3, 4), 1024);
+  auto batch = prg1.getRandomM128i(3);
+
+  AesPrg prg2(_mm_set_epi32(1, 2, 3, 4), 1024);
+  ASSERT_EQ(batch.size(), 3);
+  for (auto& item : batch) {
+    auto expected = prg2.getRandomM128i();
+    EXPECT_EQ(_mm_extract_epi64(item, 0), _mm_extract_epi64(expected, 0));
+    EXPECT_EQ(_mm_extract_epi64(item, 1), _mm_extract_epi64(expected, 1));
+  }
+}
+
+// a prg that returns one byte less than requested.
+class ShortPrg final : public IPrg {
+ public:
+  std::vector<bool> getRandomBits(uint32_t size) override {
+    return std::vector<bool>(size);
+  }
+
+  std::vector<unsigned char> getRandomBytes(uint32_t size) override {
+    return std::vector<unsigned char>(size - 1);
+  }
+};
+
+TEST(IPrgTest, testGetRandomM128iBatchSizeMismatch) {
+  ShortPrg prg;
+  EXPECT_THROW(prg.getRandomM128i(3), std::runtime_error);
+  EXPECT_EQ(prg.getRandomM128i(0).size(), 0);
+}
+
 TEST(AesPrgTest, testInPlaceGeneration) {
   __m128i aes_key = _mm_set_epi32(1, 2, 3, 4);
   AesPrg prg1(aes_key);
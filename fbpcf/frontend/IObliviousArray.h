@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "fbpcf/frontend/Int.h"
+
+namespace fbpcf::frontend {
+
+/**
+ * An oblivious array stores a fixed number of secret values of type T (a
+ * secret, non-batch Bit or Int) and allows reading and writing them at secret
+ * indexes, without revealing which position was accessed.
+ */
+template <typename T, int8_t indexWidth, int schedulerId>
+class IObliviousArray {
+ public:
+  using IndexType = Int<false, indexWidth, true, schedulerId, false>;
+
+  virtual ~IObliviousArray() = default;
+
+  // the number of values in this array.
+  virtual size_t getSize() const = 0;
+
+  /**
+   * Read the value at a secret position. The result is unspecified if the
+   * index is not smaller than the size of the array.
+   */
+  virtual T read(const IndexType& index) = 0;
+
+  /**
+   * Overwrite the value at a secret position. Nothing is changed if the index
+   * is not smaller than the size of the array.
+   */
+  virtual void write(const IndexType& index, const T& value) = 0;
+};
+
+} // namespace fbpcf::frontend
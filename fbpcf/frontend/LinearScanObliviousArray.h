@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "fbpcf/frontend/Bit.h"
+#include "fbpcf/frontend/IObliviousArray.h"
+#include "fbpcf/frontend/Int.h"
+#include "fbpcf/frontend/Vectorizer.h"
+
+namespace fbpcf::frontend {
+
+/**
+ * An oblivious array that touches every position on each access. All values
+ * are kept in one batch, so an access is a constant number of batched gates:
+ * one batched comparison of the index against every position, then one
+ * composite AND (read) or multiplexer (write) over the whole batch. The AND
+ * gate count is linear in the size of the array, which is the cheapest option
+ * for small arrays.
+ */
+template <typename T, int8_t indexWidth, int schedulerId>
+class LinearScanObliviousArray final
+    : public IObliviousArray<T, indexWidth, schedulerId> {
+  using IndexType =
+      typename IObliviousArray<T, indexWidth, schedulerId>::IndexType;
+  using BatchType = typename BatchOf<T>::type;
+
+ public:
+  explicit LinearScanObliviousArray(const std::vector<T>& values);
+
+  /**
+   * @inherit doc
+   */
+  size_t getSize() const override {
+    return size_;
+  }
+
+  /**
+   * @inherit doc
+   */
+  T read(const IndexType& index) override;
+
+  /**
+   * @inherit doc
+   */
+  void write(const IndexType& index, const T& value) override;
+
+ private:
+  // a batch of bits, the only set bit is at the position given by the index.
+  Bit<true, schedulerId, true> getIndicator(const IndexType& index) const;
+
+  size_t size_;
+  BatchType values_;
+  Int<false, indexWidth, false, schedulerId, true> positions_;
+};
+
+} // namespace fbpcf::frontend
+
+#include "fbpcf/frontend/LinearScanObliviousArray_impl.h"
@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <stdexcept>
+#include <type_traits>
+
+// included for clangd resolution. Should not execute during compilation
+#include "fbpcf/frontend/LinearScanObliviousArray.h"
+
+namespace fbpcf::frontend {
+
+namespace detail {
+
+// the bits of a batch of secret integers.
+template <bool isSigned, int8_t width, int schedulerId>
+std::vector<Bit<true, schedulerId, true>> getBits(
+    const Int<isSigned, width, true, schedulerId, true>& src) {
+  std::vector<Bit<true, schedulerId, true>> rst;
+  rst.reserve(width);
+  for (int8_t i = 0; i < width; i++) {
+    rst.push_back(src[i]);
+  }
+  return rst;
+}
+
+} // namespace detail
+
+template <typename T, int8_t indexWidth, int schedulerId>
+LinearScanObliviousArray<T, indexWidth, schedulerId>::LinearScanObliviousArray(
+    const std::vector<T>& values)
+    : size_(values.size()) {
+  if (size_ == 0) {
+    throw std::invalid_argument("Can't create an empty oblivious array.");
+  }
+  if (indexWidth < 64 && size_ > (uint64_t(1) << indexWidth)) {
+    throw std::invalid_argument("Index width is too small for this size.");
+  }
+  values_ = toBatch(values);
+  std::vector<uint64_t> positions(size_);
+  for (size_t i = 0; i < size_; i++) {
+    positions[i] = i;
+  }
+  positions_ = Int<false, indexWidth, false, schedulerId, true>(positions);
+}
+
+template <typename T, int8_t indexWidth, int schedulerId>
+T LinearScanObliviousArray<T, indexWidth, schedulerId>::read(
+    const IndexType& index) {
+  auto indicator = getIndicator(index);
+  // every value except the selected one becomes 0, so the XOR of all values
+  // is the selected value.
+  if constexpr (std::is_same_v<T, Bit<true, schedulerId, false>>) {
+    return xorAll(indicator & values_);
+  } else {
+    auto selected = indicator & detail::getBits(values_);
+    typename T::ExtractedInt rst;
+    for (size_t i = 0; i < selected.size(); i++) {
+      rst[i] = xorAll(selected.at(i)).extractBit();
+    }
+    return T(std::move(rst));
+  }
+}
+
+template <typename T, int8_t indexWidth, int schedulerId>
+void LinearScanObliviousArray<T, indexWidth, schedulerId>::write(
+    const IndexType& index,
+    const T& value) {
+  auto indicator = getIndicator(index);
+  auto newValues = broadcast(value, size_);
+  if constexpr (std::is_same_v<T, Bit<true, schedulerId, false>>) {
+    values_ = values_ ^ (indicator & (values_ ^ newValues));
+  } else {
+    values_ = values_.mux(indicator, newValues);
+  }
+}
+
+template <typename T, int8_t indexWidth, int schedulerId>
+Bit<true, schedulerId, true>
+LinearScanObliviousArray<T, indexWidth, schedulerId>::getIndicator(
+    const IndexType& index) const {
+  return positions_ == broadcast(index, size_);
+}
+
+} // namespace fbpcf::frontend
@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "fbpcf/frontend/IObliviousArray.h"
+#include "fbpcf/frontend/LinearScanObliviousArray.h"
+
+namespace fbpcf::frontend {
+
+/**
+ * An array of secret values (secret, non-batch Bits or Ints) that can be read
+ * and written at secret indexes, e.g. for lookup tables or join-like logic.
+ * The access pattern is hidden by the underlying oblivious array: a linear
+ * scan by default, which is the best choice for small arrays; larger arrays
+ * should plug in an ORAM-based implementation.
+ */
+template <typename T, int8_t indexWidth, int schedulerId>
+class SecretArray {
+ public:
+  using IndexType = Int<false, indexWidth, true, schedulerId, false>;
+
+  /**
+   * Create an array holding the given values, backed by a linear scan.
+   */
+  explicit SecretArray(const std::vector<T>& values)
+      : SecretArray(std::make_unique<
+                    LinearScanObliviousArray<T, indexWidth, schedulerId>>(
+            values)) {}
+
+  /**
+   * Create an array backed by the given oblivious array.
+   */
+  explicit SecretArray(
+      std::unique_ptr<IObliviousArray<T, indexWidth, schedulerId>> array)
+      : array_(std::move(array)) {
+    if (array_ == nullptr) {
+      throw std::invalid_argument("Oblivious array can't be empty.");
+    }
+  }
+
+  size_t size() const {
+    return array_->getSize();
+  }
+
+  /**
+   * Read the value at a secret position.
+   */
+  T read(const IndexType& index) {
+    return array_->read(index);
+  }
+
+  /**
+   * Overwrite the value at a secret position.
+   */
+  void write(const IndexType& index, const T& value) {
+    array_->write(index, value);
+  }
+
+ private:
+  std::unique_ptr<IObliviousArray<T, indexWidth, schedulerId>> array_;
+};
+
+} // namespace fbpcf::frontend
@@ -0,0 +1,268 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "fbpcf/frontend/Bit.h"
+#include "fbpcf/frontend/Int.h"
+
+namespace fbpcf::frontend {
+
+/**
+ * Helpers to run row-at-a-time application code in batch mode.
+ *
+ * Application code that loops over rows and operates on scalar Bits/Ints
+ * creates one tiny gate per row and operation. If the loop body is written
+ * once as a generic lambda (taking `auto` parameters), vectorize() runs it a
+ * single time on batch types instead, so that every operation becomes one
+ * batched gate covering all rows:
+ *
+ *   auto sums = vectorize(
+ *       [](const auto& a, const auto& b) { return a + b; }, column1, column2);
+ *
+ * Moving between scalar and batch values only repacks secret shares (or
+ * public values) locally, it doesn't require any communication.
+ */
+
+// maps a scalar frontend type to its batch counterpart
+template <typename T>
+struct BatchOf;
+
+template <bool isSecret, int schedulerId>
+struct BatchOf<Bit<isSecret, schedulerId, false>> {
+  using type = Bit<isSecret, schedulerId, true>;
+};
+
+template <bool isSigned, int8_t width, bool isSecret, int schedulerId>
+struct BatchOf<Int<isSigned, width, isSecret, schedulerId, false>> {
+  using type = Int<isSigned, width, isSecret, schedulerId, true>;
+};
+
+// maps a batch frontend type to its scalar counterpart
+template <typename T>
+struct ScalarOf;
+
+template <bool isSecret, int schedulerId>
+struct ScalarOf<Bit<isSecret, schedulerId, true>> {
+  using type = Bit<isSecret, schedulerId, false>;
+};
+
+template <bool isSigned, int8_t width, bool isSecret, int schedulerId>
+struct ScalarOf<Int<isSigned, width, isSecret, schedulerId, true>> {
+  using type = Int<isSigned, width, isSecret, schedulerId, false>;
+};
+
+/**
+ * Pack a column of scalar bits into one batch bit.
+ */
+template <bool isSecret, int schedulerId>
+Bit<isSecret, schedulerId, true> toBatch(
+    const std::vector<Bit<isSecret, schedulerId, false>>& src) {
+  std::vector<bool> values(src.size());
+  for (size_t i = 0; i < src.size(); i++) {
+    if constexpr (isSecret) {
+      values[i] = src.at(i).extractBit().getValue();
+    } else {
+      values[i] = src.at(i).getValue();
+    }
+  }
+  if constexpr (isSecret) {
+    return Bit<true, schedulerId, true>(
+        typename Bit<true, schedulerId, true>::ExtractedBit(values));
+  } else {
+    return Bit<false, schedulerId, true>(values);
+  }
+}
+
+/**
+ * Pack a column of scalar integers into one batch integer.
+ */
+template <bool isSigned, int8_t width, bool isSecret, int schedulerId>
+Int<isSigned, width, isSecret, schedulerId, true> toBatch(
+    const std::vector<Int<isSigned, width, isSecret, schedulerId, false>>&
+        src) {
+  using BatchInt = Int<isSigned, width, isSecret, schedulerId, true>;
+  if constexpr (isSecret) {
+    typename BatchInt::ExtractedInt shares;
+    for (int8_t j = 0; j < width; j++) {
+      std::vector<bool> plane(src.size());
+      for (size_t i = 0; i < src.size(); i++) {
+        plane[i] = src.at(i)[j].extractBit().getValue();
+      }
+      shares[j] =
+          typename Bit<true, schedulerId, true>::ExtractedBit(std::move(plane));
+    }
+    return BatchInt(std::move(shares));
+  } else {
+    using UnitIntType =
+        typename std::conditional<isSigned, int64_t, uint64_t>::type;
+    std::vector<UnitIntType> values(src.size());
+    for (size_t i = 0; i < src.size(); i++) {
+      values[i] = src.at(i).getValue();
+    }
+    return BatchInt(values);
+  }
+}
+
+/**
+ * Split a batch bit into one scalar bit per row.
+ */
+template <bool isSecret, int schedulerId>
+std::vector<Bit<isSecret, schedulerId, false>> fromBatch(
+    const Bit<isSecret, schedulerId, true>& src) {
+  std::vector<Bit<isSecret, schedulerId, false>> rst;
+  if constexpr (isSecret) {
+    auto shares = src.extractBit().getValue();
+    rst.reserve(shares.size());
+    for (size_t i = 0; i < shares.size(); i++) {
+      rst.emplace_back(
+          typename Bit<true, schedulerId, false>::ExtractedBit(shares.at(i)));
+    }
+  } else {
+    auto values = src.getValue();
+    rst.reserve(values.size());
+    for (size_t i = 0; i < values.size(); i++) {
+      rst.emplace_back(bool(values.at(i)));
+    }
+  }
+  return rst;
+}
+
+/**
+ * Split a batch integer into one scalar integer per row.
+ */
+template <bool isSigned, int8_t width, bool isSecret, int schedulerId>
+std::vector<Int<isSigned, width, isSecret, schedulerId, false>> fromBatch(
+    const Int<isSigned, width, isSecret, schedulerId, true>& src) {
+  using ScalarInt = Int<isSigned, width, isSecret, schedulerId, false>;
+  std::vector<ScalarInt> rst;
+  if constexpr (isSecret) {
+    std::vector<std::vector<bool>> planes(width);
+    for (int8_t j = 0; j < width; j++) {
+      planes[j] = src[j].extractBit().getValue();
+    }
+    auto batchSize = planes.at(0).size();
+    rst.reserve(batchSize);
+    for (size_t i = 0; i < batchSize; i++) {
+      typename ScalarInt::ExtractedInt shares;
+      for (int8_t j = 0; j < width; j++) {
+        shares[j] = typename Bit<true, schedulerId, false>::ExtractedBit(
+            planes.at(j).at(i));
+      }
+      rst.emplace_back(std::move(shares));
+    }
+  } else {
+    auto values = src.getValue();
+    rst.reserve(values.size());
+    for (size_t i = 0; i < values.size(); i++) {
+      rst.emplace_back(values.at(i));
+    }
+  }
+  return rst;
+}
+
+/**
+ * Repeat a scalar bit `batchSize` times as a batch bit.
+ */
+template <bool isSecret, int schedulerId>
+Bit<isSecret, schedulerId, true> broadcast(
+    const Bit<isSecret, schedulerId, false>& src,
+    size_t batchSize) {
+  if constexpr (isSecret) {
+    return Bit<true, schedulerId, true>(
+        typename Bit<true, schedulerId, true>::ExtractedBit(
+            std::vector<bool>(batchSize, src.extractBit().getValue())));
+  } else {
+    return Bit<false, schedulerId, true>(
+        std::vector<bool>(batchSize, src.getValue()));
+  }
+}
+
+/**
+ * XOR all values of a batch of secret bits into a scalar bit. XOR is linear,
+ * so every party does this on its own shares without communication.
+ */
+template <int schedulerId>
+Bit<true, schedulerId, false> xorAll(const Bit<true, schedulerId, true>& src) {
+  bool rst = false;
+  for (auto share : src.extractBit().getValue()) {
+    rst ^= share;
+  }
+  return Bit<true, schedulerId, false>(
+      typename Bit<true, schedulerId, false>::ExtractedBit(rst));
+}
+
+/**
+ * Repeat a scalar integer `batchSize` times as a batch integer.
+ */
+template <bool isSigned, int8_t width, bool isSecret, int schedulerId>
+Int<isSigned, width, isSecret, schedulerId, true> broadcast(
+    const Int<isSigned, width, isSecret, schedulerId, false>& src,
+    size_t batchSize) {
+  using BatchInt = Int<isSigned, width, isSecret, schedulerId, true>;
+  if constexpr (isSecret) {
+    typename BatchInt::ExtractedInt shares;
+    for (int8_t j = 0; j < width; j++) {
+      shares[j] = typename Bit<true, schedulerId, true>::ExtractedBit(
+          std::vector<bool>(batchSize, src[j].extractBit().getValue()));
+    }
+    return BatchInt(std::move(shares));
+  } else {
+    using UnitIntType =
+        typename std::conditional<isSigned, int64_t, uint64_t>::type;
+    return BatchInt(std::vector<UnitIntType>(batchSize, src.getValue()));
+  }
+}
+
+namespace detail {
+
+template <typename T>
+auto fromBatchResult(const T& batchResult) {
+  return fromBatch(batchResult);
+}
+
+template <typename... T>
+auto fromBatchResult(const std::tuple<T...>& batchResults) {
+  return std::apply(
+      [](const auto&... results) {
+        return std::make_tuple(fromBatch(results)...);
+      },
+      batchResults);
+}
+
+} // namespace detail
+
+/**
+ * Run `body` over all rows of the given columns in batch mode. `body` must
+ * accept the batch counterparts of the column types (e.g. a generic lambda
+ * that is also usable row by row) and return a batch Bit/Int or a tuple of
+ * them. The result is split back into one scalar value per row; for tuple
+ * results a tuple of columns is returned.
+ */
+template <typename Body, typename... Columns>
+auto vectorize(Body&& body, const std::vector<Columns>&... columns) {
+  static_assert(sizeof...(Columns) > 0, "Need at least one input column.");
+  std::vector<size_t> sizes{columns.size()...};
+  for (auto size : sizes) {
+    if (size != sizes.at(0)) {
+      throw std::invalid_argument("All columns must have the same size.");
+    }
+  }
+  if (sizes.at(0) == 0) {
+    throw std::invalid_argument("Can't vectorize empty columns.");
+  }
+  auto batchResult = body(toBatch(columns)...);
+  return detail::fromBatchResult(batchResult);
+}
+
+} // namespace fbpcf::frontend
@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+#include <future>
+#include <random>
+#include <stdexcept>
+
+#include "fbpcf/engine/communication/test/AgentFactoryCreationHelper.h"
+#include "fbpcf/frontend/SecretArray.h"
+#include "fbpcf/scheduler/PlaintextScheduler.h"
+#include "fbpcf/scheduler/WireKeeper.h"
+#include "fbpcf/test/TestHelper.h"
+
+namespace fbpcf::frontend {
+
+const int8_t kIndexWidth = 5;
+
+struct SecretArrayTestData {
+  std::vector<int64_t> initialValues;
+  std::vector<std::pair<uint64_t, int64_t>> writes;
+  std::vector<uint64_t> reads;
+};
+
+// run some writes, then some reads and open the results to party 0
+template <int schedulerId>
+std::vector<int64_t> secretArrayTask(const SecretArrayTestData& data) {
+  using SecInt = Int<true, 24, true, schedulerId, false>;
+  using SecIndex = Int<false, kIndexWidth, true, schedulerId, false>;
+
+  std::vector<SecInt> values;
+  for (auto v : data.initialValues) {
+    values.emplace_back(v, 0);
+  }
+  SecretArray<SecInt, kIndexWidth, schedulerId> array(values);
+  EXPECT_EQ(array.size(), data.initialValues.size());
+
+  // indexes are secret to party 0
+  for (auto& [index, value] : data.writes) {
+    array.write(SecIndex(index, 1), SecInt(value, 0));
+  }
+  std::vector<int64_t> rst;
+  for (auto index : data.reads) {
+    rst.push_back(array.read(SecIndex(index, 1)).openToParty(0).getValue());
+  }
+  return rst;
+}
+
+SecretArrayTestData getSecretArrayTestData(size_t size) {
+  std::random_device rd;
+  std::mt19937_64 e(rd());
+  std::uniform_int_distribution<int64_t> randomValue(-(1 << 20), 1 << 20);
+  std::uniform_int_distribution<uint64_t> randomIndex(0, size - 1);
+
+  SecretArrayTestData data;
+  for (size_t i = 0; i < size; i++) {
+    data.initialValues.push_back(randomValue(e));
+  }
+  for (size_t i = 0; i < 5; i++) {
+    data.writes.emplace_back(randomIndex(e), randomValue(e));
+  }
+  // write twice to the same position
+  data.writes.emplace_back(data.writes.at(0).first, randomValue(e));
+  for (size_t i = 0; i < size; i++) {
+    data.reads.push_back(i);
+  }
+  return data;
+}
+
+std::vector<int64_t> getExpectedReads(const SecretArrayTestData& data) {
+  auto values = data.initialValues;
+  for (auto& [index, value] : data.writes) {
+    values[index] = value;
+  }
+  std::vector<int64_t> rst;
+  for (auto index : data.reads) {
+    rst.push_back(values.at(index));
+  }
+  return rst;
+}
+
+TEST(SecretArrayTest, testLinearScanWithPlaintextScheduler) {
+  scheduler::SchedulerKeeper<0>::setScheduler(
+      std::make_unique<scheduler::PlaintextScheduler>(
+          scheduler::WireKeeper::createWithUnorderedMap()));
+  auto data = getSecretArrayTestData(23);
+  testVectorEq(secretArrayTask<0>(data), getExpectedReads(data));
+}
+
+TEST(SecretArrayTest, testLinearScan) {
+  auto agentFactories = engine::communication::getInMemoryAgentFactory(2);
+  setupRealBackend<0, 1>(*agentFactories[0], *agentFactories[1]);
+
+  auto data = getSecretArrayTestData(1 << kIndexWidth);
+  auto future0 = std::async(secretArrayTask<0>, data);
+  auto future1 = std::async(secretArrayTask<1>, data);
+  auto rst = future0.get();
+  future1.get();
+  testVectorEq(rst, getExpectedReads(data));
+}
+
+TEST(SecretArrayTest, testBits) {
+  scheduler::SchedulerKeeper<0>::setScheduler(
+      std::make_unique<scheduler::PlaintextScheduler>(
+          scheduler::WireKeeper::createWithUnorderedMap()));
+  using SecBit = Bit<true, 0, false>;
+  using SecIndex = Int<false, 2, true, 0, false>;
+
+  std::vector<bool> expected({true, false, false});
+  std::vector<SecBit> values;
+  for (auto v : expected) {
+    values.emplace_back(v, 0);
+  }
+  SecretArray<SecBit, 2, 0> array(values);
+  array.write(SecIndex(1u, 0), SecBit(true, 0));
+  array.write(SecIndex(0u, 0), SecBit(false, 0));
+  // out of range, ignored
+  array.write(SecIndex(3u, 0), SecBit(true, 0));
+  expected[1] = true;
+  expected[0] = false;
+  for (size_t i = 0; i < expected.size(); i++) {
+    EXPECT_EQ(
+        array.read(SecIndex(i, 0)).openToParty(0).getValue(), expected[i]);
+  }
+
+  EXPECT_THROW(
+      (SecretArray<SecBit, 2, 0>(std::vector<SecBit>(5))),
+      std::invalid_argument);
+  EXPECT_THROW(
+      (SecretArray<SecBit, 2, 0>(std::vector<SecBit>())),
+      std::invalid_argument);
+}
+
+} // namespace fbpcf::frontend
@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+#include <random>
+#include <stdexcept>
+#include <tuple>
+
+#include "fbpcf/frontend/Vectorizer.h"
+#include "fbpcf/scheduler/PlaintextScheduler.h"
+#include "fbpcf/scheduler/WireKeeper.h"
+#include "fbpcf/test/TestHelper.h"
+
+namespace fbpcf::frontend {
+
+TEST(VectorizerTest, testBatchConversion) {
+  scheduler::SchedulerKeeper<0>::setScheduler(
+      std::make_unique<scheduler::PlaintextScheduler>(
+          scheduler::WireKeeper::createWithUnorderedMap()));
+  using SecInt = Integer<Secret<Signed<32>>, 0>;
+  using PubInt = Integer<Public<Unsigned<16>>, 0>;
+  using SecBit = Bit<true, 0>;
+
+  std::random_device rd;
+  std::mt19937_64 e(rd());
+  std::uniform_int_distribution<int32_t> dist;
+  std::uniform_int_distribution<uint16_t> dist16;
+
+  size_t batchSize = 17;
+  int partyId = 0;
+  std::vector<int64_t> secValues(batchSize);
+  std::vector<uint64_t> pubValues(batchSize);
+  std::vector<bool> bitValues(batchSize);
+  std::vector<SecInt> secInts;
+  std::vector<PubInt> pubInts;
+  std::vector<SecBit> secBits;
+  for (size_t i = 0; i < batchSize; i++) {
+    secValues[i] = dist(e);
+    pubValues[i] = dist16(e);
+    bitValues[i] = dist(e) & 1;
+    secInts.emplace_back(secValues.at(i), partyId);
+    pubInts.emplace_back(pubValues.at(i));
+    secBits.emplace_back(bitValues.at(i), partyId);
+  }
+
+  auto secBatch = toBatch(secInts);
+  static_assert(std::is_same_v<decltype(secBatch), BatchOf<SecInt>::type>);
+  testVectorEq(secBatch.openToParty(partyId).getValue(), secValues);
+  testVectorEq(toBatch(pubInts).getValue(), pubValues);
+  testVectorEq(toBatch(secBits).openToParty(partyId).getValue(), bitValues);
+
+  auto secRows = fromBatch(secBatch);
+  ASSERT_EQ(secRows.size(), batchSize);
+  for (size_t i = 0; i < batchSize; i++) {
+    EXPECT_EQ(secRows.at(i).openToParty(partyId).getValue(), secValues.at(i));
+  }
+  auto pubRows = fromBatch(toBatch(pubInts));
+  ASSERT_EQ(pubRows.size(), batchSize);
+  for (size_t i = 0; i < batchSize; i++) {
+    EXPECT_EQ(pubRows.at(i).getValue(), pubValues.at(i));
+  }
+  auto bitRows = fromBatch(toBatch(secBits));
+  ASSERT_EQ(bitRows.size(), batchSize);
+  for (size_t i = 0; i < batchSize; i++) {
+    EXPECT_EQ(bitRows.at(i).openToParty(partyId).getValue(), bitValues.at(i));
+  }
+
+  bool parity = false;
+  for (auto v : bitValues) {
+    parity ^= v;
+  }
+  EXPECT_EQ(xorAll(toBatch(secBits)).openToParty(partyId).getValue(), parity);
+  testVectorEq(
+      broadcast(SecBit(parity, partyId), batchSize)
+          .openToParty(partyId)
+          .getValue(),
+      std::vector<bool>(batchSize, parity));
+}
+
+TEST(VectorizerTest, testVectorize) {
+  scheduler::SchedulerKeeper<0>::setScheduler(
+      std::make_unique<scheduler::PlaintextScheduler>(
+          scheduler::WireKeeper::createWithUnorderedMap()));
+  using SecInt = Integer<Secret<Signed<32>>, 0>;
+  using PubInt = Integer<Public<Signed<32>>, 0>;
+
+  std::random_device rd;
+  std::mt19937_64 e(rd());
+  std::uniform_int_distribution<int32_t> dist(-(1 << 20), 1 << 20);
+
+  size_t batchSize = 50;
+  int partyId = 1;
+  std::vector<int64_t> values1(batchSize);
+  std::vector<int64_t> values2(batchSize);
+  std::vector<SecInt> column1;
+  std::vector<PubInt> column2;
+  for (size_t i = 0; i < batchSize; i++) {
+    values1[i] = dist(e);
+    values2[i] = dist(e);
+    column1.emplace_back(values1.at(i), partyId);
+    column2.emplace_back(values2.at(i));
+  }
+
+  // the same body works row by row and in batch mode
+  auto body = [](const auto& a, const auto& b) {
+    auto sum = a + b;
+    return std::make_tuple(sum, sum < a);
+  };
+
+  auto [sums, comparisons] = vectorize(body, column1, column2);
+
+  ASSERT_EQ(sums.size(), batchSize);
+  ASSERT_EQ(comparisons.size(), batchSize);
+  for (size_t i = 0; i < batchSize; i++) {
+    EXPECT_EQ(
+        sums.at(i).openToParty(partyId).getValue(),
+        values1.at(i) + values2.at(i));
+    EXPECT_EQ(
+        comparisons.at(i).openToParty(partyId).getValue(),
+        values1.at(i) + values2.at(i) < values1.at(i));
+
+    auto [rowSum, rowComparison] = body(column1.at(i), column2.at(i));
+    EXPECT_EQ(
+        rowSum.openToParty(partyId).getValue(), values1.at(i) + values2.at(i));
+  }
+
+  EXPECT_THROW(
+      vectorize(body, column1, std::vector<PubInt>(3)), std::invalid_argument);
+  EXPECT_THROW(
+      vectorize(body, std::vector<SecInt>(), std::vector<PubInt>()),
+      std::invalid_argument);
+}
+
+} // namespace fbpcf::frontend
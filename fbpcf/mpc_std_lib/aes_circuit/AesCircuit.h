@@ -7,35 +7,59 @@
 
 #pragma once
 
+#include <array>
+#include <cstdint>
+#include <vector>
+
 #include "fbpcf/mpc_std_lib/aes_circuit/IAesCircuit.h"
 
 namespace fbpcf::mpc_std_lib::aes_circuit {
 
 /*
- * This is the implementation of AES circuit
+ * This is the implementation of AES circuit. A block is 128 consecutive bits,
+ * where bit 8 * i + j is bit j (from the least significant) of the i-th byte of
+ * the block, in the same order as the bytes of an __m128i. The expanded key is
+ * made of the 11 round keys in the same layout. The S-box is the 34 AND gate,
+ * AND-depth 4 circuit of Boyar and Peralta, so with a lazy scheduler all the
+ * S-boxes of a round, across all bytes and blocks, are evaluated in 4 batched
+ * AND levels. The key schedule reuses the S-box circuit on 4 bytes per round.
  */
 template <typename BitType>
 class AesCircuit : public IAesCircuit<BitType> {
+ protected:
+  using ByteType = std::array<BitType, 8>;
+  using WordType = std::array<ByteType, 4>;
+  // a block is made of 4 columns.
+  using BlockType = std::array<WordType, 4>;
+
  private:
+  /**
+   * @inherit doc
+   */
+  std::vector<BitType> expandKey_impl(
+      const std::vector<BitType>& key) const override;
+
+  /**
+   * @inherit doc
+   */
   std::vector<BitType> encrypt_impl(
       const std::vector<BitType>& plaintext,
-      const std::vector<BitType>& expandedEncKey) const;
+      const std::vector<BitType>& expandedEncKey) const override;
 
-  using ByteType = std::array<BitType, 8>;
-  using WordType = std::array<ByteType, 4>;
   /**
    * @inherit doc
    */
   std::vector<BitType> decrypt_impl(
       const std::vector<BitType>& ciphertext,
-      const std::vector<BitType>& expandedDecKey) const;
+      const std::vector<BitType>& expandedDecKey) const override;
 
  protected:
-  std::vector<std::array<WordType, 4>> convertToWords(
-      const std::vector<BitType>& src) const;
+  std::vector<BlockType> convertToWords(const std::vector<BitType>& src) const;
 
   std::vector<BitType> convertFromWords(
-      std::vector<std::array<WordType, 4>>& src) const;
+      const std::vector<BlockType>& src) const;
+
+  void addRoundKeyInPlace(BlockType& src, const BlockType& roundKey) const;
 
   void sBoxInPlace(ByteType& src) const;
   void inverseSBoxInPlace(ByteType& src) const;
@@ -43,7 +67,21 @@ class AesCircuit : public IAesCircuit<BitType> {
   void mixColumnsInPlace(WordType& src) const;
   void inverseMixColumnsInPlace(WordType& src) const;
 
-  void shiftRowInPlace(WordType& src, int8_t offset);
+  // rotate the bytes of a row to the left by offset.
+  void shiftRowInPlace(WordType& src, int8_t offset) const;
+  void shiftRowsInPlace(BlockType& src) const;
+  void inverseShiftRowsInPlace(BlockType& src) const;
+
+ private:
+  static const int8_t kRound = 10;
+
+  // multiply a byte by x in GF(2^8).
+  ByteType xtime(const ByteType& src) const;
+
+  // the inverse of the affine transformation of the S-box.
+  ByteType inverseAffine(const ByteType& src) const;
 };
 
 } // namespace fbpcf::mpc_std_lib::aes_circuit
+
+#include "fbpcf/mpc_std_lib/aes_circuit/AesCircuit_impl.h"
@@ -10,55 +10,411 @@
 #include <vector>
 namespace fbpcf::mpc_std_lib::aes_circuit {
 
+template <typename BitType>
+std::vector<BitType> AesCircuit<BitType>::expandKey_impl(
+    const std::vector<BitType>& key) const {
+  const std::array<uint8_t, kRound> kRoundConstants = {
+      0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x1b, 0x36};
+  std::vector<BlockType> roundKeys = convertToWords(key);
+  roundKeys.reserve(kRound + 1);
+  for (int8_t round = 1; round <= kRound; round++) {
+    auto& previous = roundKeys.at(round - 1);
+    // RotWord and SubWord on the last word of the previous round key.
+    WordType temp;
+    for (size_t i = 0; i < 4; i++) {
+      temp[i] = previous[3][(i + 1) % 4];
+      sBoxInPlace(temp[i]);
+    }
+    for (size_t j = 0; j < 8; j++) {
+      if ((kRoundConstants.at(round - 1) >> j) & 1) {
+        temp[0][j] = !temp[0][j];
+      }
+    }
+    BlockType roundKey;
+    for (size_t i = 0; i < 4; i++) {
+      for (size_t k = 0; k < 4; k++) {
+        for (size_t j = 0; j < 8; j++) {
+          temp[k][j] = temp[k][j] ^ previous[i][k][j];
+        }
+      }
+      roundKey[i] = temp;
+    }
+    roundKeys.push_back(std::move(roundKey));
+  }
+  return convertFromWords(roundKeys);
+}
+
 template <typename BitType>
 std::vector<BitType> AesCircuit<BitType>::encrypt_impl(
     const std::vector<BitType>& plaintext,
     const std::vector<BitType>& expandedEncKey) const {
-  throw std::runtime_error("Not implemented!");
+  auto blocks = convertToWords(plaintext);
+  auto roundKeys = convertToWords(expandedEncKey);
+  for (auto& block : blocks) {
+    addRoundKeyInPlace(block, roundKeys.at(0));
+  }
+  for (int8_t round = 1; round <= kRound; round++) {
+    for (auto& block : blocks) {
+      for (auto& word : block) {
+        for (auto& byte : word) {
+          sBoxInPlace(byte);
+        }
+      }
+      shiftRowsInPlace(block);
+      if (round != kRound) {
+        for (auto& word : block) {
+          mixColumnsInPlace(word);
+        }
+      }
+      addRoundKeyInPlace(block, roundKeys.at(round));
+    }
+  }
+  return convertFromWords(blocks);
 }
 
 template <typename BitType>
 std::vector<BitType> AesCircuit<BitType>::decrypt_impl(
     const std::vector<BitType>& ciphertext,
     const std::vector<BitType>& expandedDecKey) const {
-  throw std::runtime_error("Not implemented!");
+  auto blocks = convertToWords(ciphertext);
+  auto roundKeys = convertToWords(expandedDecKey);
+  for (auto& block : blocks) {
+    addRoundKeyInPlace(block, roundKeys.at(kRound));
+  }
+  for (int8_t round = kRound - 1; round >= 0; round--) {
+    for (auto& block : blocks) {
+      inverseShiftRowsInPlace(block);
+      for (auto& word : block) {
+        for (auto& byte : word) {
+          inverseSBoxInPlace(byte);
+        }
+      }
+      addRoundKeyInPlace(block, roundKeys.at(round));
+      if (round != 0) {
+        for (auto& word : block) {
+          inverseMixColumnsInPlace(word);
+        }
+      }
+    }
+  }
+  return convertFromWords(blocks);
 }
 
 template <typename BitType>
-std::vector<std::array<AesCircuit<BitType>::WordType, 4>>
+std::vector<typename AesCircuit<BitType>::BlockType>
 AesCircuit<BitType>::convertToWords(const std::vector<BitType>& src) const {
-  throw std::runtime_error("Not implemented!");
+  std::vector<BlockType> rst(src.size() / 128);
+  for (size_t i = 0; i < rst.size(); i++) {
+    for (size_t j = 0; j < 4; j++) {
+      for (size_t k = 0; k < 4; k++) {
+        for (size_t l = 0; l < 8; l++) {
+          rst[i][j][k][l] = src.at(i * 128 + j * 32 + k * 8 + l);
+        }
+      }
+    }
+  }
+  return rst;
 }
 
 template <typename BitType>
 std::vector<BitType> AesCircuit<BitType>::convertFromWords(
-    std::vector<std::array<WordType, 4>>& src) const {
-  throw std::runtime_error("Not implemented!");
+    const std::vector<BlockType>& src) const {
+  std::vector<BitType> rst;
+  rst.reserve(src.size() * 128);
+  for (auto& block : src) {
+    for (auto& word : block) {
+      for (auto& byte : word) {
+        rst.insert(rst.end(), byte.begin(), byte.end());
+      }
+    }
+  }
+  return rst;
 }
 
+template <typename BitType>
+void AesCircuit<BitType>::addRoundKeyInPlace(
+    BlockType& src,
+    const BlockType& roundKey) const {
+  for (size_t i = 0; i < 4; i++) {
+    for (size_t j = 0; j < 4; j++) {
+      for (size_t k = 0; k < 8; k++) {
+        src[i][j][k] = src[i][j][k] ^ roundKey[i][j][k];
+      }
+    }
+  }
+}
+
+/*
+ * The circuit is from "A depth-16 circuit for the AES S-box" by Boyar and
+ * Peralta. It has 34 AND gates in 4 levels. U0 and S0 are the most significant
+ * bits.
+ */
 template <typename BitType>
 void AesCircuit<BitType>::sBoxInPlace(ByteType& src) const {
-  throw std::runtime_error("Not implemented!");
+  auto& u0 = src[7];
+  auto& u1 = src[6];
+  auto& u2 = src[5];
+  auto& u3 = src[4];
+  auto& u4 = src[3];
+  auto& u5 = src[2];
+  auto& u6 = src[1];
+  auto& u7 = src[0];
+
+  // top linear transformation
+  auto t1 = u0 ^ u3;
+  auto t2 = u0 ^ u5;
+  auto t3 = u0 ^ u6;
+  auto t4 = u3 ^ u5;
+  auto t5 = u4 ^ u6;
+  auto t6 = t1 ^ t5;
+  auto t7 = u1 ^ u2;
+  auto t8 = u7 ^ t6;
+  auto t9 = u7 ^ t7;
+  auto t10 = t6 ^ t7;
+  auto t11 = u1 ^ u5;
+  auto t12 = u2 ^ u5;
+  auto t13 = t3 ^ t4;
+  auto t14 = t6 ^ t11;
+  auto t15 = t5 ^ t11;
+  auto t16 = t5 ^ t12;
+  auto t17 = t9 ^ t16;
+  auto t18 = u3 ^ u7;
+  auto t19 = t7 ^ t18;
+  auto t20 = t1 ^ t19;
+  auto t21 = u6 ^ u7;
+  auto t22 = t7 ^ t21;
+  auto t23 = t2 ^ t22;
+  auto t24 = t2 ^ t10;
+  auto t25 = t20 ^ t17;
+  auto t26 = t3 ^ t16;
+  auto t27 = t1 ^ t12;
+
+  // nonlinear middle part
+  auto m1 = t13 & t6;
+  auto m2 = t23 & t8;
+  auto m3 = t14 ^ m1;
+  auto m4 = t19 & u7;
+  auto m5 = m4 ^ m1;
+  auto m6 = t3 & t16;
+  auto m7 = t22 & t9;
+  auto m8 = t26 ^ m6;
+  auto m9 = t20 & t17;
+  auto m10 = m9 ^ m6;
+  auto m11 = t1 & t15;
+  auto m12 = t4 & t27;
+  auto m13 = m12 ^ m11;
+  auto m14 = t2 & t10;
+  auto m15 = m14 ^ m11;
+  auto m16 = m3 ^ m2;
+  auto m17 = m5 ^ t24;
+  auto m18 = m8 ^ m7;
+  auto m19 = m10 ^ m15;
+  auto m20 = m16 ^ m13;
+  auto m21 = m17 ^ m15;
+  auto m22 = m18 ^ m13;
+  auto m23 = m19 ^ t25;
+  auto m24 = m22 ^ m23;
+  auto m25 = m22 & m20;
+  auto m26 = m21 ^ m25;
+  auto m27 = m20 ^ m21;
+  auto m28 = m23 ^ m25;
+  auto m29 = m28 & m27;
+  auto m30 = m26 & m24;
+  auto m31 = m20 & m23;
+  auto m32 = m27 & m31;
+  auto m33 = m27 ^ m25;
+  auto m34 = m21 & m22;
+  auto m35 = m24 & m34;
+  auto m36 = m24 ^ m25;
+  auto m37 = m21 ^ m29;
+  auto m38 = m32 ^ m33;
+  auto m39 = m23 ^ m30;
+  auto m40 = m35 ^ m36;
+  auto m41 = m38 ^ m40;
+  auto m42 = m37 ^ m39;
+  auto m43 = m37 ^ m38;
+  auto m44 = m39 ^ m40;
+  auto m45 = m42 ^ m41;
+  auto m46 = m44 & t6;
+  auto m47 = m40 & t8;
+  auto m48 = m39 & u7;
+  auto m49 = m43 & t16;
+  auto m50 = m38 & t9;
+  auto m51 = m37 & t17;
+  auto m52 = m42 & t15;
+  auto m53 = m45 & t27;
+  auto m54 = m41 & t10;
+  auto m55 = m44 & t13;
+  auto m56 = m40 & t23;
+  auto m57 = m39 & t19;
+  auto m58 = m43 & t3;
+  auto m59 = m38 & t22;
+  auto m60 = m37 & t20;
+  auto m61 = m42 & t1;
+  auto m62 = m45 & t4;
+  auto m63 = m41 & t2;
+
+  // bottom linear transformation
+  auto l0 = m61 ^ m62;
+  auto l1 = m50 ^ m56;
+  auto l2 = m46 ^ m48;
+  auto l3 = m47 ^ m55;
+  auto l4 = m54 ^ m58;
+  auto l5 = m49 ^ m61;
+  auto l6 = m62 ^ l5;
+  auto l7 = m46 ^ l3;
+  auto l8 = m51 ^ m59;
+  auto l9 = m52 ^ m53;
+  auto l10 = m53 ^ l4;
+  auto l11 = m60 ^ l2;
+  auto l12 = m48 ^ m51;
+  auto l13 = m50 ^ l0;
+  auto l14 = m52 ^ m61;
+  auto l15 = m55 ^ l1;
+  auto l16 = m56 ^ l0;
+  auto l17 = m57 ^ l1;
+  auto l18 = m58 ^ l8;
+  auto l19 = m63 ^ l4;
+  auto l20 = l0 ^ l1;
+  auto l21 = l1 ^ l7;
+  auto l22 = l3 ^ l12;
+  auto l23 = l18 ^ l2;
+  auto l24 = l15 ^ l9;
+  auto l25 = l6 ^ l10;
+  auto l26 = l7 ^ l9;
+  auto l27 = l8 ^ l10;
+  auto l28 = l11 ^ l14;
+  auto l29 = l11 ^ l17;
+
+  src[7] = l6 ^ l24;
+  src[6] = !(l16 ^ l26);
+  src[5] = !(l19 ^ l28);
+  src[4] = l6 ^ l21;
+  src[3] = l20 ^ l22;
+  src[2] = l25 ^ l29;
+  src[1] = !(l13 ^ l27);
+  src[0] = !(l6 ^ l23);
 }
 
+/*
+ * The S-box is the affine transformation A applied to the inverse in GF(2^8),
+ * so its inverse is A^-1(S(A^-1(x))) and costs the same AND gates.
+ */
 template <typename BitType>
 void AesCircuit<BitType>::inverseSBoxInPlace(ByteType& src) const {
-  throw std::runtime_error("Not implemented!");
+  src = inverseAffine(src);
+  sBoxInPlace(src);
+  src = inverseAffine(src);
+}
+
+template <typename BitType>
+typename AesCircuit<BitType>::ByteType AesCircuit<BitType>::inverseAffine(
+    const ByteType& src) const {
+  // the constant of the inverse transformation is 0x05.
+  const uint8_t kConstant = 0x05;
+  ByteType rst;
+  for (size_t i = 0; i < 8; i++) {
+    rst[i] = src[(i + 2) % 8] ^ src[(i + 5) % 8] ^ src[(i + 7) % 8];
+    if ((kConstant >> i) & 1) {
+      rst[i] = !rst[i];
+    }
+  }
+  return rst;
+}
+
+template <typename BitType>
+typename AesCircuit<BitType>::ByteType AesCircuit<BitType>::xtime(
+    const ByteType& src) const {
+  // shift left and reduce by x^8 + x^4 + x^3 + x + 1.
+  ByteType rst;
+  rst[0] = src[7];
+  rst[1] = src[0] ^ src[7];
+  rst[2] = src[1];
+  rst[3] = src[2] ^ src[7];
+  rst[4] = src[3] ^ src[7];
+  rst[5] = src[4];
+  rst[6] = src[5];
+  rst[7] = src[6];
+  return rst;
 }
 
 template <typename BitType>
 void AesCircuit<BitType>::mixColumnsInPlace(WordType& src) const {
-  throw std::runtime_error("Not implemented!");
+  // rst[i] = 2 * src[i] + 3 * src[i + 1] + src[i + 2] + src[i + 3]
+  WordType rst;
+  for (size_t i = 0; i < 4; i++) {
+    auto& a0 = src[i];
+    auto& a1 = src[(i + 1) % 4];
+    auto& a2 = src[(i + 2) % 4];
+    auto& a3 = src[(i + 3) % 4];
+    ByteType sum;
+    for (size_t j = 0; j < 8; j++) {
+      sum[j] = a0[j] ^ a1[j];
+    }
+    auto doubled = xtime(sum);
+    for (size_t j = 0; j < 8; j++) {
+      rst[i][j] = doubled[j] ^ a1[j] ^ a2[j] ^ a3[j];
+    }
+  }
+  src = std::move(rst);
 }
 
+/*
+ * The inverse matrix is the forward one times (4x^2 + 5), which is cheaper to
+ * compute: src[i] += 4 * (src[i] + src[i + 2]) before mixing columns.
+ */
 template <typename BitType>
 void AesCircuit<BitType>::inverseMixColumnsInPlace(WordType& src) const {
-  throw std::runtime_error("Not implemented!");
+  for (size_t i = 0; i < 2; i++) {
+    ByteType sum;
+    for (size_t j = 0; j < 8; j++) {
+      sum[j] = src[i][j] ^ src[i + 2][j];
+    }
+    auto quadrupled = xtime(xtime(sum));
+    for (size_t j = 0; j < 8; j++) {
+      src[i][j] = src[i][j] ^ quadrupled[j];
+      src[i + 2][j] = src[i + 2][j] ^ quadrupled[j];
+    }
+  }
+  mixColumnsInPlace(src);
+}
+
+template <typename BitType>
+void AesCircuit<BitType>::shiftRowInPlace(WordType& src, int8_t offset)
+    const {
+  WordType rst;
+  for (int8_t i = 0; i < 4; i++) {
+    rst[i] = std::move(src[(i + offset) % 4]);
+  }
+  src = std::move(rst);
+}
+
+template <typename BitType>
+void AesCircuit<BitType>::shiftRowsInPlace(BlockType& src) const {
+  for (int8_t row = 1; row < 4; row++) {
+    WordType bytes;
+    for (size_t column = 0; column < 4; column++) {
+      bytes[column] = std::move(src[column][row]);
+    }
+    shiftRowInPlace(bytes, row);
+    for (size_t column = 0; column < 4; column++) {
+      src[column][row] = std::move(bytes[column]);
+    }
+  }
 }
 
 template <typename BitType>
-void AesCircuit<BitType>::shiftRowInPlace(WordType& src, int8_t offset) {
-  throw std::runtime_error("Not implemented!");
+void AesCircuit<BitType>::inverseShiftRowsInPlace(BlockType& src) const {
+  for (int8_t row = 1; row < 4; row++) {
+    WordType bytes;
+    for (size_t column = 0; column < 4; column++) {
+      bytes[column] = std::move(src[column][row]);
+    }
+    shiftRowInPlace(bytes, 4 - row);
+    for (size_t column = 0; column < 4; column++) {
+      src[column][row] = std::move(bytes[column]);
+    }
+  }
 }
 
 } // namespace fbpcf::mpc_std_lib::aes_circuit
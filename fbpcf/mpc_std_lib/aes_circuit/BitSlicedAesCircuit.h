@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "fbpcf/mpc_std_lib/aes_circuit/AesCircuit.h"
+#include "fbpcf/mpc_std_lib/aes_circuit/IAesCircuit.h"
+
+namespace fbpcf::mpc_std_lib::aes_circuit::insecure {
+
+/*
+ * 64 plaintext bits packed in one word, one from each of 64 AES blocks.
+ */
+struct BitSlicedWord {
+  uint64_t value = 0;
+
+  BitSlicedWord operator&(const BitSlicedWord& other) const {
+    return {value & other.value};
+  }
+
+  BitSlicedWord operator^(const BitSlicedWord& other) const {
+    return {value ^ other.value};
+  }
+
+  BitSlicedWord operator!() const {
+    return {~value};
+  }
+};
+
+/*
+ * This object evaluates the gates of AesCircuit in plaintext on 64 blocks at a
+ * time, with one machine instruction per gate. It produces the same results as
+ * AesCircuit<bool>, but is much faster, which makes it a reference for tests
+ * and benchmarks. It offers no security.
+ */
+class BitSlicedAesCircuit final : public IAesCircuit<bool> {
+ public:
+  static const size_t kBlocksPerWord = 64;
+
+ private:
+  /**
+   * @inherit doc
+   */
+  std::vector<bool> expandKey_impl(
+      const std::vector<bool>& key) const override {
+    // a single key is cheap to expand without bit slicing.
+    return AesCircuit<bool>().expandKey(key);
+  }
+
+  /**
+   * @inherit doc
+   */
+  std::vector<bool> encrypt_impl(
+      const std::vector<bool>& plaintext,
+      const std::vector<bool>& expandedEncKey) const override {
+    return evaluate(plaintext, expandedEncKey, true);
+  }
+
+  /**
+   * @inherit doc
+   */
+  std::vector<bool> decrypt_impl(
+      const std::vector<bool>& ciphertext,
+      const std::vector<bool>& expandedDecKey) const override {
+    return evaluate(ciphertext, expandedDecKey, false);
+  }
+
+  std::vector<bool> evaluate(
+      const std::vector<bool>& src,
+      const std::vector<bool>& expandedKey,
+      bool isEncryption) const {
+    // every word of the key is the same bit for all blocks.
+    std::vector<BitSlicedWord> keyWords(expandedKey.size());
+    for (size_t i = 0; i < keyWords.size(); i++) {
+      keyWords[i].value = expandedKey.at(i) ? ~uint64_t(0) : 0;
+    }
+
+    auto blockCount = src.size() / 128;
+    std::vector<bool> rst(src.size());
+    std::vector<BitSlicedWord> words(128);
+    for (size_t start = 0; start < blockCount; start += kBlocksPerWord) {
+      auto count = std::min(kBlocksPerWord, blockCount - start);
+      for (size_t i = 0; i < 128; i++) {
+        uint64_t value = 0;
+        for (size_t j = 0; j < count; j++) {
+          value |= uint64_t(src[(start + j) * 128 + i]) << j;
+        }
+        words[i].value = value;
+      }
+      auto output = isEncryption ? circuit_.encrypt(words, keyWords)
+                                 : circuit_.decrypt(words, keyWords);
+      for (size_t i = 0; i < 128; i++) {
+        for (size_t j = 0; j < count; j++) {
+          rst[(start + j) * 128 + i] = (output.at(i).value >> j) & 1;
+        }
+      }
+    }
+    return rst;
+  }
+
+  AesCircuit<BitSlicedWord> circuit_;
+};
+
+} // namespace fbpcf::mpc_std_lib::aes_circuit::insecure
@@ -0,0 +1,29 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <memory>
+
+#include "fbpcf/mpc_std_lib/aes_circuit/BitSlicedAesCircuit.h"
+#include "fbpcf/mpc_std_lib/aes_circuit/IAesCircuitFactory.h"
+
+namespace fbpcf::mpc_std_lib::aes_circuit::insecure {
+
+class BitSlicedAesCircuitFactory final : public IAesCircuitFactory<bool> {
+ public:
+  std::unique_ptr<IAesCircuit<bool>> create() override {
+    return std::make_unique<BitSlicedAesCircuit>();
+  }
+
+  // it computes the real AES, but only as a plaintext reference.
+  CircuitType getCircuitType() const override {
+    return CircuitType::Plaintext;
+  }
+};
+
+} // namespace fbpcf::mpc_std_lib::aes_circuit::insecure
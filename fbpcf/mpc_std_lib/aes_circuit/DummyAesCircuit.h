@@ -20,6 +20,18 @@ namespace fbpcf::mpc_std_lib::aes_circuit::insecure {
 template <typename BitType>
 class DummyAesCircuit final : public IAesCircuit<BitType> {
  private:
+  /**
+   * @inherit doc
+   */
+  std::vector<BitType> expandKey_impl(const std::vector<BitType>& key) const {
+    std::vector<BitType> rst;
+    rst.reserve(IAesCircuit<BitType>::kExpandedKeyWidth);
+    while (rst.size() < IAesCircuit<BitType>::kExpandedKeyWidth) {
+      rst.insert(rst.end(), key.begin(), key.end());
+    }
+    return rst;
+  }
+
   std::vector<BitType> encrypt_impl(
       const std::vector<BitType>& plaintext,
       const std::vector<BitType>& /* expandedEncKey */) const {
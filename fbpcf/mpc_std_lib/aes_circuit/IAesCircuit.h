@@ -16,8 +16,7 @@ namespace fbpcf::mpc_std_lib::aes_circuit {
 /*
  * An AES circuit object implements the AES algorithm at a conceptual-bit level.
  * This "conceptual bit" can be anything that has an isomorphic behavior
- * regarding AND and XOR as normal bits. Currently we only support decryption.
- * We may add support for encryption in future.
+ * regarding AND and XOR as normal bits.
  */
 /**
  * Bit type can be either bool or any MPC Bit types.
@@ -29,8 +28,23 @@ class IAesCircuit {
       1408; /** The expanded AES key contains 11 16-byte keys. 1408 = 11 * 16 *
                8 **/
 
+  static const size_t kKeyWidth = 128;
+
   virtual ~IAesCircuit() = default;
 
+  /**
+   * Expand an AES key into the round keys for encryption and decryption. The
+   * expanded key can be reused for any number of blocks.
+   * @param key the AES key inside MPC. It must be 128 bits.
+   * @return the expanded key inside MPC;
+   */
+  std::vector<BitType> expandKey(const std::vector<BitType>& key) const {
+    if (key.size() != kKeyWidth) {
+      throw std::runtime_error("AES key must be 128 bits.");
+    }
+    return expandKey_impl(key);
+  }
+
   /**
    * Encrypt the plaintext with the expanded key.
    * @param plaintext the plaintext for AES inside MPC. It must be a
@@ -55,8 +69,9 @@ class IAesCircuit {
    * decrypt the ciphertext with the expanded key.
    * @param ciphertext the ciphertext for AES inside MPC. It must be a
    * multiplication of 128.
-   * @param expandedKey the expanded AES key inside MPC. It must be the
-   * expected expanded key size.
+   * @param expandedDecKey the expanded AES key inside MPC. It must be the
+   * expected expanded key size. The round keys are in the same order as those
+   * for encryption.
    * @return the plaintext inside MPC;
    */
   std::vector<BitType> decrypt(
@@ -72,6 +87,9 @@ class IAesCircuit {
   }
 
  private:
+  virtual std::vector<BitType> expandKey_impl(
+      const std::vector<BitType>& key) const = 0;
+
   virtual std::vector<BitType> encrypt_impl(
       const std::vector<BitType>& plaintext,
       const std::vector<BitType>& expandedEncKey) const = 0;
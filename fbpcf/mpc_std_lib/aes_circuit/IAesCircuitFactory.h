@@ -20,6 +20,8 @@ class IAesCircuitFactory {
   enum CircuitType {
     Dummy,
     Secure,
+    // computes the real AES in plaintext, only as a reference.
+    Plaintext,
   };
 
   virtual CircuitType getCircuitType() const = 0;
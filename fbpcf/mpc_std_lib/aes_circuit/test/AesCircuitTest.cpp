@@ -14,7 +14,11 @@
 #include <unordered_map>
 
 #include "fbpcf/engine/communication/test/AgentFactoryCreationHelper.h"
+#include "fbpcf/engine/util/aes.h"
+#include "fbpcf/frontend/Bit.h"
 #include "fbpcf/mpc_std_lib/aes_circuit/AesCircuit.h"
+#include "fbpcf/mpc_std_lib/aes_circuit/AesCircuitFactory.h"
+#include "fbpcf/mpc_std_lib/aes_circuit/BitSlicedAesCircuitFactory.h"
 #include "fbpcf/mpc_std_lib/aes_circuit/DummyAesCircuitFactory.h"
 #include "fbpcf/mpc_std_lib/aes_circuit/IAesCircuit.h"
 #include "fbpcf/mpc_std_lib/util/test/util.h"
@@ -46,6 +50,9 @@ void testDummyAesCircuitInPlaintext(
   testVectorEq(rst1, plaintext);
   auto rst2 = DummyAesCircuit->decrypt(rst1, dummyKey);
   testVectorEq(rst2, rst1);
+  EXPECT_EQ(
+      DummyAesCircuit->expandKey(generateRandomPlaintext()).size(),
+      dummyKey.size());
 }
 
 TEST(AesCircuitTest, testDummyAesCircuit) {
@@ -53,4 +60,214 @@ TEST(AesCircuitTest, testDummyAesCircuit) {
       std::make_unique<insecure::DummyAesCircuitFactory<bool>>());
 }
 
+// expose the round keys of the AES implementation in the engine.
+class AesWithRoundKeys : public engine::util::Aes {
+ public:
+  explicit AesWithRoundKeys(__m128i key) : Aes(key) {}
+
+  std::vector<bool> getExpandedKey() const {
+    std::vector<bool> rst;
+    for (auto& roundKey : roundKey_) {
+      auto bits = blockToBits(roundKey);
+      rst.insert(rst.end(), bits.begin(), bits.end());
+    }
+    return rst;
+  }
+
+  static std::vector<bool> blockToBits(__m128i block) {
+    std::array<uint8_t, 16> bytes;
+    _mm_storeu_si128((__m128i*)bytes.data(), block);
+    std::vector<bool> rst(128);
+    for (size_t i = 0; i < 128; i++) {
+      rst[i] = (bytes.at(i / 8) >> (i % 8)) & 1;
+    }
+    return rst;
+  }
+
+  static __m128i bitsToBlock(const std::vector<bool>& bits, size_t offset) {
+    std::array<uint8_t, 16> bytes{};
+    for (size_t i = 0; i < 128; i++) {
+      bytes[i / 8] |= bits.at(offset + i) << (i % 8);
+    }
+    return _mm_loadu_si128((const __m128i*)bytes.data());
+  }
+};
+
+class AesCircuitForTest : public AesCircuit<bool> {
+ public:
+  using AesCircuit<bool>::ByteType;
+  using AesCircuit<bool>::sBoxInPlace;
+  using AesCircuit<bool>::inverseSBoxInPlace;
+};
+
+TEST(AesCircuitTest, testSBox) {
+  AesCircuitForTest circuit;
+  auto toByte = [](uint8_t v) {
+    AesCircuitForTest::ByteType rst;
+    for (size_t i = 0; i < 8; i++) {
+      rst[i] = (v >> i) & 1;
+    }
+    return rst;
+  };
+  auto fromByte = [](const AesCircuitForTest::ByteType& v) {
+    uint8_t rst = 0;
+    for (size_t i = 0; i < 8; i++) {
+      rst |= v[i] << i;
+    }
+    return rst;
+  };
+
+  auto byte = toByte(0x00);
+  circuit.sBoxInPlace(byte);
+  EXPECT_EQ(fromByte(byte), 0x63);
+  byte = toByte(0x53);
+  circuit.sBoxInPlace(byte);
+  EXPECT_EQ(fromByte(byte), 0xed);
+
+  std::vector<bool> seen(256, false);
+  for (int i = 0; i < 256; i++) {
+    byte = toByte(i);
+    circuit.sBoxInPlace(byte);
+    seen[fromByte(byte)] = true;
+    circuit.inverseSBoxInPlace(byte);
+    EXPECT_EQ(fromByte(byte), i);
+  }
+  for (auto v : seen) {
+    EXPECT_TRUE(v);
+  }
+}
+
+TEST(AesCircuitTest, testKeyExpansion) {
+  auto key = generateRandomPlaintext();
+  AesWithRoundKeys aes(AesWithRoundKeys::bitsToBlock(key, 0));
+  auto expected = aes.getExpandedKey();
+
+  testVectorEq(AesCircuitFactory<bool>().create()->expandKey(key), expected);
+  testVectorEq(
+      insecure::BitSlicedAesCircuitFactory().create()->expandKey(key),
+      expected);
+  EXPECT_THROW(
+      AesCircuitFactory<bool>().create()->expandKey(std::vector<bool>(127)),
+      std::runtime_error);
+}
+
+TEST(AesCircuitTest, testAesCircuitInPlaintext) {
+  size_t blockCount = 5;
+  auto key = AesWithRoundKeys::bitsToBlock(generateRandomPlaintext(), 0);
+  AesWithRoundKeys aes(key);
+  auto expandedKey = aes.getExpandedKey();
+  auto plaintext = generateRandomPlaintext(128 * blockCount);
+
+  std::vector<__m128i> expected(blockCount);
+  for (size_t i = 0; i < blockCount; i++) {
+    expected[i] = AesWithRoundKeys::bitsToBlock(plaintext, i * 128);
+  }
+  aes.encryptInPlace(expected);
+
+  auto circuit = AesCircuitFactory<bool>().create();
+  auto ciphertext = circuit->encrypt(plaintext, expandedKey);
+  ASSERT_EQ(ciphertext.size(), plaintext.size());
+  for (size_t i = 0; i < blockCount; i++) {
+    testVectorEq(
+        std::vector<bool>(
+            ciphertext.begin() + i * 128, ciphertext.begin() + (i + 1) * 128),
+        AesWithRoundKeys::blockToBits(expected.at(i)));
+  }
+  testVectorEq(circuit->decrypt(ciphertext, expandedKey), plaintext);
+}
+
+TEST(AesCircuitTest, testBitSlicedAesCircuit) {
+  // not a multiple of the blocks per word.
+  size_t blockCount = 100;
+  auto key = AesWithRoundKeys::bitsToBlock(generateRandomPlaintext(), 0);
+  AesWithRoundKeys aes(key);
+  auto expandedKey = aes.getExpandedKey();
+  auto plaintext = generateRandomPlaintext(128 * blockCount);
+
+  std::vector<__m128i> expected(blockCount);
+  for (size_t i = 0; i < blockCount; i++) {
+    expected[i] = AesWithRoundKeys::bitsToBlock(plaintext, i * 128);
+  }
+  aes.encryptInPlace(expected);
+
+  auto factory = std::make_unique<insecure::BitSlicedAesCircuitFactory>();
+  EXPECT_EQ(
+      factory->getCircuitType(),
+      IAesCircuitFactory<bool>::CircuitType::Plaintext);
+  auto circuit = factory->create();
+  auto ciphertext = circuit->encrypt(plaintext, expandedKey);
+  ASSERT_EQ(ciphertext.size(), plaintext.size());
+  for (size_t i = 0; i < blockCount; i++) {
+    testVectorEq(
+        std::vector<bool>(
+            ciphertext.begin() + i * 128, ciphertext.begin() + (i + 1) * 128),
+        AesWithRoundKeys::blockToBits(expected.at(i)));
+  }
+  testVectorEq(circuit->decrypt(ciphertext, expandedKey), plaintext);
+}
+
+// party 0 inputs the plaintext and party 1 inputs the key, which is expanded
+// in MPC. Each bit of the input is a batch of the corresponding bits of all
+// blocks.
+template <int schedulerId>
+std::pair<std::vector<std::vector<bool>>, std::vector<std::vector<bool>>>
+aesCircuitTask(
+    const std::vector<std::vector<bool>>& plaintext,
+    const std::vector<bool>& key) {
+  using SecBit = frontend::Bit<true, schedulerId, true>;
+  auto batchSize = plaintext.at(0).size();
+  std::vector<SecBit> plaintextBits;
+  for (auto& bits : plaintext) {
+    plaintextBits.emplace_back(bits, 0);
+  }
+  std::vector<SecBit> keyBits;
+  for (auto bit : key) {
+    keyBits.emplace_back(std::vector<bool>(batchSize, bit), 1);
+  }
+  auto circuit = AesCircuitFactory<SecBit>().create();
+  keyBits = circuit->expandKey(keyBits);
+  auto ciphertextBits = circuit->encrypt(plaintextBits, keyBits);
+  auto decryptedBits = circuit->decrypt(ciphertextBits, keyBits);
+  std::vector<std::vector<bool>> ciphertext;
+  std::vector<std::vector<bool>> decrypted;
+  for (size_t i = 0; i < ciphertextBits.size(); i++) {
+    ciphertext.push_back(ciphertextBits.at(i).openToParty(0).getValue());
+    decrypted.push_back(decryptedBits.at(i).openToParty(0).getValue());
+  }
+  return {ciphertext, decrypted};
+}
+
+TEST(AesCircuitTest, testAesCircuitInMpc) {
+  auto agentFactories = engine::communication::getInMemoryAgentFactory(2);
+  setupRealBackend<0, 1>(*agentFactories[0], *agentFactories[1]);
+
+  size_t blockCount = 10;
+  auto key = generateRandomPlaintext();
+  AesWithRoundKeys aes(AesWithRoundKeys::bitsToBlock(key, 0));
+  std::vector<std::vector<bool>> plaintext(128, std::vector<bool>(blockCount));
+  std::vector<__m128i> expected(blockCount);
+  for (size_t i = 0; i < blockCount; i++) {
+    auto block = generateRandomPlaintext();
+    for (size_t j = 0; j < 128; j++) {
+      plaintext[j][i] = block.at(j);
+    }
+    expected[i] = AesWithRoundKeys::bitsToBlock(block, 0);
+  }
+  aes.encryptInPlace(expected);
+
+  auto future0 = std::async(aesCircuitTask<0>, plaintext, key);
+  auto future1 = std::async(aesCircuitTask<1>, plaintext, key);
+  auto [ciphertext, decrypted] = future0.get();
+  future1.get();
+  for (size_t i = 0; i < blockCount; i++) {
+    auto expectedBits = AesWithRoundKeys::blockToBits(expected.at(i));
+    for (size_t j = 0; j < 128; j++) {
+      EXPECT_EQ(ciphertext.at(j).at(i), expectedBits.at(j));
+    }
+  }
+  for (size_t j = 0; j < 128; j++) {
+    testVectorEq(decrypted.at(j), plaintext.at(j));
+  }
+}
+
 } // namespace fbpcf::mpc_std_lib::aes_circuit
@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <folly/Benchmark.h>
+#include <memory>
+#include <random>
+#include <vector>
+#include "common/init/Init.h"
+
+#include "fbpcf/mpc_std_lib/aes_circuit/AesCircuitFactory.h"
+#include "fbpcf/mpc_std_lib/aes_circuit/BitSlicedAesCircuitFactory.h"
+#include "fbpcf/mpc_std_lib/aes_circuit/IAesCircuitFactory.h"
+#include "folly/BenchmarkUtil.h"
+
+namespace fbpcf::mpc_std_lib::aes_circuit {
+
+DEFINE_int64(
+    AesCircuit_Benchmark_BlockCount,
+    1024,
+    "The number of blocks to encrypt in plaintext");
+
+std::vector<bool> generateRandomBits(size_t size) {
+  std::random_device rd;
+  std::mt19937_64 e(rd());
+  std::uniform_int_distribution<uint8_t> dist(0, 1);
+  std::vector<bool> rst(size);
+  for (size_t i = 0; i < size; i++) {
+    rst[i] = dist(e);
+  }
+  return rst;
+}
+
+void encryptInPlaintext(uint32_t n, IAesCircuitFactory<bool>& factory) {
+  folly::BenchmarkSuspender braces;
+  auto circuit = factory.create();
+  auto plaintext =
+      generateRandomBits(128 * FLAGS_AesCircuit_Benchmark_BlockCount);
+  auto expandedKey = generateRandomBits(IAesCircuit<bool>::kExpandedKeyWidth);
+  braces.dismiss();
+
+  while (n--) {
+    folly::doNotOptimizeAway(circuit->encrypt(plaintext, expandedKey));
+  }
+}
+
+BENCHMARK(AesCircuit_encrypt, n) {
+  AesCircuitFactory<bool> factory;
+  encryptInPlaintext(n, factory);
+}
+
+BENCHMARK_RELATIVE(BitSlicedAesCircuit_encrypt, n) {
+  insecure::BitSlicedAesCircuitFactory factory;
+  encryptInPlaintext(n, factory);
+}
+} // namespace fbpcf::mpc_std_lib::aes_circuit
+
+int main(int argc, char* argv[]) {
+  facebook::initFacebook(&argc, &argv);
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  folly::runBenchmarks();
+  return 0;
+}
@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <functional>
+#include <map>
+#include <memory>
+#include "fbpcf/engine/communication/IPartyCommunicationAgentFactory.h"
+#include "fbpcf/mpc_std_lib/oram/IWriteOnlyOramFactory.h"
+#include "fbpcf/mpc_std_lib/oram/LinearOramFactory.h"
+#include "fbpcf/mpc_std_lib/oram/OramCostModel.h"
+#include "fbpcf/mpc_std_lib/oram/WriteOnlyOramFactory.h"
+#include "fbpcf/mpc_std_lib/util/util.h"
+
+namespace fbpcf::mpc_std_lib::oram {
+
+/**
+ * A write-only oram factory that picks the implementation for each oram, and
+ * the number of threads for it, with a cost model. The choice is based on the
+ * oram size and the expected batch size of obliviousAddBatch, which must be the
+ * same for both parties.
+ */
+template <typename T>
+class AdaptiveWriteOnlyOramFactory final : public IWriteOnlyOramFactory<T> {
+ public:
+  // creates a factory of tree-based write-only orams with a thread count.
+  using WriteOnlyOramFactoryCreator =
+      std::function<std::unique_ptr<IWriteOnlyOramFactory<T>>(size_t)>;
+
+  AdaptiveWriteOnlyOramFactory(
+      std::unique_ptr<IWriteOnlyOramFactory<T>> linearOramFactory,
+      WriteOnlyOramFactoryCreator writeOnlyOramFactoryCreator,
+      size_t batchSize,
+      size_t indicatorSumWidth,
+      size_t maxThreadCount = 1,
+      OramCostModel costModel = OramCostModel())
+      : linearOramFactory_(std::move(linearOramFactory)),
+        writeOnlyOramFactoryCreator_(std::move(writeOnlyOramFactoryCreator)),
+        batchSize_(batchSize),
+        indicatorSumWidth_(indicatorSumWidth),
+        maxThreadCount_(maxThreadCount),
+        costModel_(costModel),
+        valueWidth_(util::Adapters<T>::convertToBits(T(0)).size()) {}
+
+  std::unique_ptr<IWriteOnlyOram<T>> create(size_t size) override {
+    return getFactory(size).create(size);
+  }
+
+  /**
+   * @inherit doc
+   */
+  uint32_t getMaxBatchSize(size_t size, uint8_t concurrency) override {
+    return getFactory(size).getMaxBatchSize(size, concurrency);
+  }
+
+  /**
+   * The implementation that this factory uses for an oram of the given size.
+   */
+  OramCostModel::Choice choose(size_t size) const {
+    return costModel_.choose(
+        size, batchSize_, valueWidth_, indicatorSumWidth_, maxThreadCount_);
+  }
+
+ private:
+  IWriteOnlyOramFactory<T>& getFactory(size_t size) {
+    auto choice = choose(size);
+    if (choice.useLinearOram) {
+      return *linearOramFactory_;
+    }
+    auto& factory = writeOnlyOramFactories_[choice.threadCount];
+    if (factory == nullptr) {
+      factory = writeOnlyOramFactoryCreator_(choice.threadCount);
+    }
+    return *factory;
+  }
+
+  std::unique_ptr<IWriteOnlyOramFactory<T>> linearOramFactory_;
+  WriteOnlyOramFactoryCreator writeOnlyOramFactoryCreator_;
+  // the tree-based factories that have been created, by thread count.
+  std::map<size_t, std::unique_ptr<IWriteOnlyOramFactory<T>>>
+      writeOnlyOramFactories_;
+  size_t batchSize_;
+  size_t indicatorSumWidth_;
+  size_t maxThreadCount_;
+  OramCostModel costModel_;
+  size_t valueWidth_;
+};
+
+/**
+ * Create a factory that picks the secure linear or tree-based write-only oram
+ * for each oram size.
+ * @param batchSize the expected number of values per obliviousAddBatch call.
+ */
+template <typename T, int indicatorSumWidth, int schedulerId>
+std::unique_ptr<IWriteOnlyOramFactory<T>>
+getSecureAdaptiveWriteOnlyOramFactory(
+    bool amIParty0,
+    int32_t party0Id,
+    int32_t party1Id,
+    engine::communication::IPartyCommunicationAgentFactory& factory,
+    size_t batchSize,
+    size_t maxThreadCount = 1,
+    OramCostModel costModel = OramCostModel()) {
+  return std::make_unique<AdaptiveWriteOnlyOramFactory<T>>(
+      getSecureLinearOramFactory<T, schedulerId>(
+          amIParty0, party0Id, party1Id, factory),
+      [amIParty0, party0Id, party1Id, &factory](size_t threadCount) {
+        return getSecureWriteOnlyOramFactory<T, indicatorSumWidth, schedulerId>(
+            amIParty0,
+            party0Id,
+            party1Id,
+            factory,
+            WriteOnlyOram<T>::kDefaultMemoryBudget,
+            threadCount);
+      },
+      batchSize,
+      indicatorSumWidth,
+      maxThreadCount,
+      costModel);
+}
+
+} // namespace fbpcf::mpc_std_lib::oram
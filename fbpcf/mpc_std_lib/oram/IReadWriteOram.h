@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace fbpcf::mpc_std_lib::oram {
+
+/*
+ * A read-write oram stores a fixed number of XOR-secret-shared values of the
+ * same bit width, and supports reading and writing them at XOR-secret-shared
+ * positions without revealing which position was accessed. Unlike
+ * IWriteOnlyOram, reads also take a secret index and return secret shares.
+ */
+class IReadWriteOram {
+ public:
+  virtual ~IReadWriteOram() = default;
+
+  // the number of values in this oram.
+  virtual size_t getSize() const = 0;
+
+  /**
+   * obliviously read a batch of values at XOR-secret-shared positions. The
+   * accesses are processed one after another. The result is unspecified for an
+   * index that is not smaller than the size of the oram.
+   * @param indexShares this party's shares of the indexes, from share batches
+   * of less significant to share batches of more significant;
+   * @return this party's XOR shares of the values, from share batches of less
+   * significant to share batches of more significant;
+   */
+  virtual std::vector<std::vector<bool>> secretReadBatch(
+      const std::vector<std::vector<bool>>& indexShares) = 0;
+
+  /**
+   * obliviously overwrite a batch of values at XOR-secret-shared positions.
+   * The writes are processed one after another, so a later write wins. Writes
+   * to an index that is not smaller than the size of the oram are ignored.
+   * @param indexShares this party's shares of the indexes, from share batches
+   * of less significant to share batches of more significant;
+   * @param valueShares this party's XOR shares of the new values, from share
+   * batches of less significant to share batches of more significant;
+   */
+  virtual void secretWriteBatch(
+      const std::vector<std::vector<bool>>& indexShares,
+      const std::vector<std::vector<bool>>& valueShares) = 0;
+};
+
+} // namespace fbpcf::mpc_std_lib::oram
@@ -0,0 +1,31 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "fbpcf/mpc_std_lib/oram/IReadWriteOram.h"
+
+namespace fbpcf::mpc_std_lib::oram {
+
+class IReadWriteOramFactory {
+ public:
+  virtual ~IReadWriteOramFactory() = default;
+
+  /**
+   * Create an oram holding the given values.
+   * @param valueShares this party's XOR shares of the initial values, from
+   * share batches of less significant to share batches of more significant;
+   * the batch size is the size of the oram.
+   */
+  virtual std::unique_ptr<IReadWriteOram> create(
+      const std::vector<std::vector<bool>>& valueShares) = 0;
+};
+
+} // namespace fbpcf::mpc_std_lib::oram
@@ -8,6 +8,7 @@
 #pragma once
 
 #include <cstddef>
+#include <iterator>
 #include <stdexcept>
 #include "fbpcf/mpc_std_lib/util/util.h"
 
@@ -69,31 +70,34 @@ void LinearOram<T, schedulerId>::obliviousAddBatch(
   auto valueForEachIndex =
       generateInputValue(std::move(value), std::move(index), size_, batchSize);
 
-  // party 1's share
-  std::vector<SecBatchT> shares1;
-
-  for (size_t i = 0; i < valueForEachIndex.size(); i++) {
-    std::vector<T> share0ForThisIndex(batchSize, T(0));
-    // generate a random value as party 0's share
-    if (myRole_ == Role::Alice) {
-      for (auto& item : share0ForThisIndex) {
-        item = util::Adapters<T>::generateFromKey(prg_->getRandomM128i());
-        memory_[i] = memory_.at(i) + item;
+  // generate random values as party 0's shares for all the indexes at once.
+  std::vector<T> share0Plaintext(size_ * batchSize, T(0));
+  if (myRole_ == Role::Alice) {
+    auto keys = prg_->getRandomM128i(share0Plaintext.size());
+    util::BulkAdapters<T>::generateFromKeys(
+        keys.data(), keys.size(), share0Plaintext.data());
+    for (size_t i = 0; i < size_; i++) {
+      for (size_t j = 0; j < batchSize; j++) {
+        memory_[i] = memory_.at(i) + share0Plaintext.at(i * batchSize + j);
       }
     }
-    auto share0 = util::MpcAdapters<T, schedulerId>::processSecretInputs(
-        share0ForThisIndex, party0Id_);
-    // calculate party 1's share
-    shares1.push_back(valueForEachIndex.at(i) - share0);
   }
-
-  for (size_t i = 0; i < size_; i++) {
-    // open the difference to party 1
-    auto share1Plaintext = util::MpcAdapters<T, schedulerId>::openToParty(
-        shares1.at(i), party1Id_);
-    if (myRole_ == Role::Bob) {
-      for (auto& item : share1Plaintext) {
-        memory_[i] = memory_.at(i) + item;
+  auto share0 = util::MpcAdapters<T, schedulerId>::processSecretInputs(
+      share0Plaintext, party0Id_);
+
+  // calculate party 1's shares and open all of them to party 1 in one go.
+  std::vector<SecBatchT> otherValues(
+      std::make_move_iterator(valueForEachIndex.begin() + 1),
+      std::make_move_iterator(valueForEachIndex.end()));
+  auto shares1 = util::MpcAdapters<T, schedulerId>::batchingWith(
+                     valueForEachIndex.at(0), otherValues) -
+      share0;
+  auto share1Plaintext =
+      util::MpcAdapters<T, schedulerId>::openToParty(shares1, party1Id_);
+  if (myRole_ == Role::Bob) {
+    for (size_t i = 0; i < size_; i++) {
+      for (size_t j = 0; j < batchSize; j++) {
+        memory_[i] = memory_.at(i) + share1Plaintext.at(i * batchSize + j);
       }
     }
   }
@@ -7,6 +7,8 @@
 
 #pragma once
 
+#include <vector>
+
 namespace fbpcf::mpc_std_lib::oram {
 
 template <int schedulerId>
@@ -15,59 +17,54 @@ ObliviousDeltaCalculator<schedulerId>::calculateDelta(
     const std::vector<__m128i>& delta0Shares,
     const std::vector<__m128i>& delta1Shares,
     const std::vector<bool>& alphaShares) const {
+  using SecBatchBit = frontend::Bit<true, schedulerId, true>;
+  auto batchSize = alphaShares.size();
   auto delta0SharesBool = util::convertToBits(delta0Shares);
   auto delta1SharesBool = util::convertToBits(delta1Shares);
-  std::vector<frontend::Bit<true, schedulerId, true>> secDelta0(
-      128 /* there are 128 bits in __m128i */);
-  std::vector<frontend::Bit<true, schedulerId, true>> secDelta1(
-      128 /* there are 128 bits in __m128i */);
-  std::vector<frontend::Bit<true, schedulerId, true>> secDelta(
-      128 /* there are 128 bits in __m128i */);
+  std::vector<SecBatchBit> secDelta0(kBitsInM128i);
+  std::vector<SecBatchBit> secDelta1(kBitsInM128i);
+  std::vector<SecBatchBit> secDeltaDifference(kBitsInM128i);
 
-  frontend::Bit<true, schedulerId, true> secAlpha(
-      (typename frontend::Bit<true, schedulerId, true>::ExtractedBit(
-          alphaShares)));
+  SecBatchBit secAlpha(
+      (typename SecBatchBit::ExtractedBit(alphaShares)));
 
   for (size_t i = 0; i < kBitsInM128i; i++) {
-    secDelta0[i] = frontend::Bit<true, schedulerId, true>(
-        typename frontend::Bit<true, schedulerId, true>::ExtractedBit(
-            delta0SharesBool.at(i)));
-    secDelta1[i] = frontend::Bit<true, schedulerId, true>(
-        typename frontend::Bit<true, schedulerId, true>::ExtractedBit(
-            delta1SharesBool.at(i)));
-    secDelta[i] =
-        secDelta1.at(i) ^ ((secDelta0.at(i) ^ secDelta1.at(i)) & secAlpha);
+    secDelta0[i] = SecBatchBit(
+        typename SecBatchBit::ExtractedBit(delta0SharesBool.at(i)));
+    secDelta1[i] = SecBatchBit(
+        typename SecBatchBit::ExtractedBit(delta1SharesBool.at(i)));
+    secDeltaDifference[i] = secDelta0.at(i) ^ secDelta1.at(i);
   }
-  auto secT0 = secDelta0.at(0) ^ !secAlpha;
-  auto secT1 = secDelta1.at(0) ^ secAlpha;
-
-  auto t0Party0 = secT0.openToParty(party0Id_);
-  auto t0Party1 = secT0.openToParty(party1Id_);
+  // all 128 products share secAlpha, so they are one composite AND.
+  auto products = secAlpha & secDeltaDifference;
 
-  auto t1Party0 = secT1.openToParty(party0Id_);
-  auto t1Party1 = secT1.openToParty(party1Id_);
+  // delta, t0 and t1 are revealed together in one batch.
+  std::vector<SecBatchBit> others;
+  others.reserve(kBitsInM128i + 1);
+  for (size_t i = 1; i < kBitsInM128i; i++) {
+    others.push_back(secDelta1.at(i) ^ products.at(i));
+  }
+  others.push_back(secDelta0.at(0) ^ !secAlpha);
+  others.push_back(secDelta1.at(0) ^ secAlpha);
+  auto secBatch = (secDelta1.at(0) ^ products.at(0)).batchingWith(others);
 
-  std::vector<frontend::Bit<false, schedulerId, true>> deltaBoolParty0(
-      kBitsInM128i);
-  std::vector<frontend::Bit<false, schedulerId, true>> deltaBoolParty1(
-      kBitsInM128i);
+  auto party0Batch = secBatch.openToParty(party0Id_);
+  auto party1Batch = secBatch.openToParty(party1Id_);
+  auto revealed =
+      amIParty0_ ? party0Batch.getValue() : party1Batch.getValue();
 
   std::vector<std::vector<bool>> deltaBool(kBitsInM128i);
-
-  for (size_t i = 0; i < kBitsInM128i; i++) {
-    deltaBoolParty0[i] = secDelta.at(i).openToParty(party0Id_);
-  }
-  for (size_t i = 0; i < kBitsInM128i; i++) {
-    deltaBoolParty1[i] = secDelta.at(i).openToParty(party1Id_);
-  }
-
   for (size_t i = 0; i < kBitsInM128i; i++) {
-    deltaBool[i] = amIParty0_ ? deltaBoolParty0.at(i).getValue()
-                              : deltaBoolParty1.at(i).getValue();
+    deltaBool[i] = std::vector<bool>(
+        revealed.begin() + i * batchSize,
+        revealed.begin() + (i + 1) * batchSize);
   }
   std::vector<__m128i> delta = util::convertFromBits(deltaBool);
-  auto t0 = amIParty0_ ? t0Party0.getValue() : t0Party1.getValue();
-  auto t1 = amIParty0_ ? t1Party0.getValue() : t1Party1.getValue();
+  std::vector<bool> t0(
+      revealed.begin() + kBitsInM128i * batchSize,
+      revealed.begin() + (kBitsInM128i + 1) * batchSize);
+  std::vector<bool> t1(
+      revealed.begin() + (kBitsInM128i + 1) * batchSize, revealed.end());
 
   return {delta, t0, t1};
 }
@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "fbpcf/frontend/IObliviousArray.h"
+#include "fbpcf/mpc_std_lib/oram/IReadWriteOram.h"
+#include "fbpcf/mpc_std_lib/oram/IReadWriteOramFactory.h"
+
+namespace fbpcf::mpc_std_lib::oram {
+
+/**
+ * An oblivious array backed by a read-write oram, so that frontend::SecretArray
+ * can use an oram for large arrays. T is a secret, non-batch Bit or Int.
+ */
+template <typename T, int8_t indexWidth, int schedulerId>
+class OramBasedObliviousArray final
+    : public frontend::IObliviousArray<T, indexWidth, schedulerId> {
+  using IndexType =
+      typename frontend::IObliviousArray<T, indexWidth, schedulerId>::IndexType;
+  static constexpr bool isBit =
+      std::is_same_v<T, frontend::Bit<true, schedulerId, false>>;
+
+ public:
+  OramBasedObliviousArray(
+      const std::vector<T>& values,
+      IReadWriteOramFactory& factory) {
+    if (values.empty()) {
+      throw std::invalid_argument("Can't create an empty oblivious array.");
+    }
+    if (indexWidth < 64 && values.size() > (uint64_t(1) << indexWidth)) {
+      throw std::invalid_argument("Index width is too small for this size.");
+    }
+    std::vector<std::vector<bool>> valueShares(toShares(values.at(0)).size());
+    for (auto& value : values) {
+      auto shares = toShares(value);
+      for (size_t i = 0; i < shares.size(); i++) {
+        valueShares[i].push_back(shares.at(i));
+      }
+    }
+    oram_ = factory.create(valueShares);
+  }
+
+  /**
+   * @inherit doc
+   */
+  size_t getSize() const override {
+    return oram_->getSize();
+  }
+
+  /**
+   * @inherit doc
+   */
+  T read(const IndexType& index) override {
+    auto valueShares = oram_->secretReadBatch(toIndexShares(index));
+    if constexpr (isBit) {
+      return T(typename T::ExtractedBit(valueShares.at(0).at(0)));
+    } else {
+      typename T::ExtractedInt rst;
+      for (size_t i = 0; i < valueShares.size(); i++) {
+        rst[i] = typename frontend::Bit<true, schedulerId, false>::ExtractedBit(
+            valueShares.at(i).at(0));
+      }
+      return T(std::move(rst));
+    }
+  }
+
+  /**
+   * @inherit doc
+   */
+  void write(const IndexType& index, const T& value) override {
+    auto shares = toShares(value);
+    std::vector<std::vector<bool>> valueShares(shares.size());
+    for (size_t i = 0; i < shares.size(); i++) {
+      valueShares[i] = {shares.at(i)};
+    }
+    oram_->secretWriteBatch(toIndexShares(index), valueShares);
+  }
+
+ private:
+  static std::vector<bool> toShares(const T& value) {
+    if constexpr (isBit) {
+      return {value.extractBit().getValue()};
+    } else {
+      return value.extractIntShare().getBooleanShares();
+    }
+  }
+
+  static std::vector<std::vector<bool>> toIndexShares(const IndexType& index) {
+    auto shares = index.extractIntShare().getBooleanShares();
+    std::vector<std::vector<bool>> rst(shares.size());
+    for (size_t i = 0; i < shares.size(); i++) {
+      rst[i] = {shares.at(i)};
+    }
+    return rst;
+  }
+
+  std::unique_ptr<IReadWriteOram> oram_;
+};
+
+} // namespace fbpcf::mpc_std_lib::oram
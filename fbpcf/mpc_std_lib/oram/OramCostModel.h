@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+namespace fbpcf::mpc_std_lib::oram {
+
+/**
+ * A simple cost model to estimate the time of one obliviousAddBatch call of the
+ * write-only oram implementations, and to pick the cheaper one. The estimates
+ * count rounds, AND gates and PRG blocks, each of which is weighed by a
+ * per-unit cost. The default unit costs were fitted to obliviousAddBatch
+ * timings of the shapes in the OramSweep benchmarks of OramBenchmark.cpp on a
+ * single host; they should be refitted for other hardware, and
+ * roundTripLatency should be set to the network latency between the parties.
+ */
+struct OramCostModel {
+  // seconds per round of interaction between the two parties.
+  double roundTripLatency = 1e-3;
+  // seconds per AND gate, including the surrounding frontend work.
+  double andGateCost = 3e-7;
+  // seconds per 128-bit PRG block when expanding single point arrays.
+  double prgBlockCost = 7.5e-8;
+  // seconds LinearOram spends on each position regardless of the batch size.
+  double linearOramPositionCost = 3e-4;
+  // seconds to hand one tree level to an extra thread.
+  double threadOverhead = 5e-5;
+
+  // the number of AND gates, or equivalent work, to compute the delta of one
+  // tree level.
+  static const size_t kAndGatesPerTreeLevel = 220;
+  // the number of positions each thread should handle at least.
+  static const size_t kMinPositionsPerThread = 1 << 16;
+
+  struct Choice {
+    bool useLinearOram;
+    size_t threadCount;
+  };
+
+  /**
+   * Estimate the seconds LinearOram takes to add a batch of values. Every
+   * value is obliviously routed to all positions by a tree of swaps and the
+   * masked results are opened together.
+   */
+  double estimateLinearOramCost(
+      size_t oramSize,
+      size_t batchSize,
+      size_t valueWidth) const {
+    auto depth = getDepth(oramSize);
+    double rounds = depth + valueWidth + 1;
+    double andGates = 2.0 * batchSize * oramSize * valueWidth;
+    return rounds * roundTripLatency + andGates * andGateCost +
+        oramSize * linearOramPositionCost;
+  }
+
+  /**
+   * Estimate the seconds WriteOnlyOram takes to add a batch of values. The
+   * single point arrays need a delta calculation per tree level and a local
+   * expansion to all positions, after which the difference calculator runs
+   * once per value.
+   */
+  double estimateWriteOnlyOramCost(
+      size_t oramSize,
+      size_t batchSize,
+      size_t valueWidth,
+      size_t indicatorSumWidth,
+      size_t threadCount) const {
+    auto depth = getDepth(oramSize);
+    double rounds = 2.0 * depth + 2 * valueWidth + indicatorSumWidth + 1;
+    double andGates = 1.0 * batchSize *
+        (depth * kAndGatesPerTreeLevel + 10 * valueWidth +
+         2 * indicatorSumWidth);
+    // the trees have about 2 * oramSize nodes and each position gets a mask.
+    double prgBlocks = 3.0 * batchSize * oramSize;
+    return rounds * roundTripLatency + andGates * andGateCost +
+        prgBlocks * prgBlockCost / threadCount +
+        (threadCount - 1) * depth * threadOverhead;
+  }
+
+  /**
+   * The number of threads WriteOnlyOram should use, such that every thread has
+   * enough work to make up for its overhead.
+   */
+  size_t getThreadCount(
+      size_t oramSize,
+      size_t batchSize,
+      size_t maxThreadCount) const {
+    auto positions = oramSize * batchSize;
+    return std::max<size_t>(
+        1,
+        std::min<size_t>(maxThreadCount, positions / kMinPositionsPerThread));
+  }
+
+  /**
+   * Pick the cheaper implementation for the given shape. The result only
+   * depends on public parameters, so both parties make the same choice.
+   */
+  Choice choose(
+      size_t oramSize,
+      size_t batchSize,
+      size_t valueWidth,
+      size_t indicatorSumWidth,
+      size_t maxThreadCount) const {
+    auto threadCount = getThreadCount(oramSize, batchSize, maxThreadCount);
+    auto linearCost = estimateLinearOramCost(oramSize, batchSize, valueWidth);
+    auto writeOnlyCost = estimateWriteOnlyOramCost(
+        oramSize, batchSize, valueWidth, indicatorSumWidth, threadCount);
+    if (linearCost <= writeOnlyCost) {
+      return {true, 1};
+    }
+    return {false, threadCount};
+  }
+
+ private:
+  static size_t getDepth(size_t oramSize) {
+    return oramSize <= 1 ? 1 : std::ceil(std::log2(oramSize));
+  }
+};
+
+} // namespace fbpcf::mpc_std_lib::oram
@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "fbpcf/mpc_std_lib/oram/PreprocessedSinglePointArrayGenerator.h"
+#include <algorithm>
+#include <stdexcept>
+#include "fbpcf/engine/util/AesPrg.h"
+#include "fbpcf/engine/util/util.h"
+
+namespace fbpcf::mpc_std_lib::oram {
+
+void PreprocessedSinglePointArrayGenerator::preprocess(
+    size_t width,
+    size_t count) {
+  if ((width == 0) || (count == 0)) {
+    throw std::invalid_argument("Empty input!");
+  }
+  if (width >= 64) {
+    // width can not be larger than 63, otherwise 2^width will overflow.
+    throw std::invalid_argument("Width is too large!");
+  }
+  auto& queue = preprocessedArrays_[width];
+  if (queue.size() + count > getMaxArrayCount(width)) {
+    throw std::invalid_argument(
+        "The preprocessed arrays exceed the memory budget!");
+  }
+
+  // the shares of the random offsets are independent random bits.
+  std::vector<std::vector<bool>> offsetShares(width, std::vector<bool>(count));
+  engine::util::AesPrg prg(engine::util::getRandomM128iFromSystemNoise());
+  for (auto& item : offsetShares) {
+    prg.getRandomBitsInPlace(item);
+  }
+  auto arrays =
+      generator_->generateSinglePointArrays(offsetShares, (uint64_t)1 << width);
+
+  for (size_t i = 0; i < count; i++) {
+    std::vector<bool> offsetShare(width);
+    for (size_t j = 0; j < width; j++) {
+      offsetShare[j] = offsetShares.at(j).at(i);
+    }
+    queue.push_back(
+        {std::move(offsetShare),
+         std::move(arrays.at(i).first),
+         std::move(arrays.at(i).second)});
+  }
+}
+
+std::vector<std::pair<std::vector<bool>, std::vector<__m128i>>>
+PreprocessedSinglePointArrayGenerator::generateSinglePointArrays(
+    const std::vector<std::vector<bool>>& indexShares,
+    size_t length) {
+  auto width = indexShares.size();
+  if (width == 0) {
+    throw std::invalid_argument("Empty input!");
+  }
+  if (width >= 64) {
+    // width can not be larger than 63, otherwise 2^width will overflow.
+    throw std::invalid_argument("Width is too large!");
+  }
+  if (length > ((uint64_t)1 << width)) {
+    throw std::invalid_argument("Length is too large for the index width!");
+  }
+  size_t batchSize = indexShares.at(0).size();
+  if (batchSize == 0) {
+    throw std::invalid_argument("Empty input!");
+  }
+  for (auto& item : indexShares) {
+    if (item.size() != batchSize) {
+      throw std::invalid_argument("Inconsistent input size");
+    }
+  }
+  auto tileSize = getMaxArrayCount(width);
+  if (tileSize == 0) {
+    throw std::invalid_argument(
+        "A single array of this width exceeds the memory budget!");
+  }
+
+  ArrayType rst(batchSize);
+  auto& queue = preprocessedArrays_[width];
+  for (size_t start = 0; start < batchSize; start += tileSize) {
+    auto count = std::min(tileSize, batchSize - start);
+    if (queue.size() < count) {
+      preprocess(width, count - queue.size());
+    }
+
+    // open index ^ offset for the whole tile in a single round.
+    std::vector<bool> maskedIndexShares(width * count);
+    for (size_t j = 0; j < width; j++) {
+      for (size_t i = 0; i < count; i++) {
+        maskedIndexShares[j * count + i] =
+            indexShares.at(j).at(start + i) ^ queue.at(i).offsetShare.at(j);
+      }
+    }
+    agent_->sendBool(maskedIndexShares);
+    auto otherShares = agent_->receiveBool(maskedIndexShares.size());
+    if (otherShares.size() != maskedIndexShares.size()) {
+      throw std::runtime_error("unexpected size!");
+    }
+
+    for (size_t i = 0; i < count; i++) {
+      uint64_t shift = 0;
+      for (size_t j = 0; j < width; j++) {
+        shift |= (uint64_t)(maskedIndexShares.at(j * count + i) ^
+                            otherShares.at(j * count + i))
+            << j;
+      }
+      auto& src = queue.front();
+      auto& dst = rst[start + i];
+      dst.first = std::vector<bool>(length);
+      dst.second = std::vector<__m128i>(length);
+      for (size_t j = 0; j < length; j++) {
+        dst.first[j] = src.indicators.at(j ^ shift);
+        dst.second[j] = src.keys.at(j ^ shift);
+      }
+      queue.pop_front();
+    }
+  }
+  return rst;
+}
+
+size_t PreprocessedSinglePointArrayGenerator::getMaxArrayCount(
+    size_t width) const {
+  return (memoryBudget_ / kBytesPerPosition) >> width;
+}
+
+} // namespace fbpcf::mpc_std_lib::oram
@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <deque>
+#include <map>
+#include <memory>
+#include "fbpcf/engine/communication/IPartyCommunicationAgent.h"
+#include "fbpcf/mpc_std_lib/oram/ISinglePointArrayGenerator.h"
+
+namespace fbpcf::mpc_std_lib::oram {
+
+/**
+ * A single point array generator that needs only one round of communication
+ * per batch once it has been preprocessed. In the offline phase, the
+ * underlying generator creates arrays whose point is at a random index r that
+ * is shared by the two parties and covers the whole index domain. In the
+ * online phase, the parties open index ^ r, which reveals nothing about the
+ * index, and each of them permutes its array locally such that position j
+ * takes the value at position j ^ index ^ r, moving the point to the index.
+ * Since the preprocessed arrays cover the whole domain of 2^width positions,
+ * their memory is bounded by a budget: batches are processed in tiles that
+ * fit it, and widths whose single array exceeds it are rejected.
+ */
+class PreprocessedSinglePointArrayGenerator final
+    : public ISinglePointArrayGenerator {
+ public:
+  // the default memory budget of the preprocessed arrays, in bytes.
+  static const size_t kDefaultMemoryBudget = size_t(1) << 30;
+
+  /**
+   * @param memoryBudget the approximate amount of memory the preprocessed
+   * arrays may use, in bytes.
+   */
+  PreprocessedSinglePointArrayGenerator(
+      std::unique_ptr<ISinglePointArrayGenerator> generator,
+      std::unique_ptr<engine::communication::IPartyCommunicationAgent> agent,
+      size_t memoryBudget = kDefaultMemoryBudget)
+      : generator_(std::move(generator)),
+        agent_(std::move(agent)),
+        memoryBudget_(memoryBudget) {}
+
+  /**
+   * Generate arrays for a number of future indexes of the given width ahead of
+   * time. Both parties need to call this with the same parameters at the same
+   * time. Any arrays that are not preprocessed will be generated on demand.
+   * Throws if the preprocessed arrays of this width wouldn't fit in the
+   * memory budget.
+   */
+  void preprocess(size_t width, size_t count);
+
+  /**
+   * @inherit doc
+   */
+  std::vector<std::pair<std::vector<bool>, std::vector<__m128i>>>
+  generateSinglePointArrays(
+      const std::vector<std::vector<bool>>& indexShares,
+      size_t length) override;
+
+  std::pair<uint64_t, uint64_t> getTrafficStatistics() const override {
+    auto [sent, received] = generator_->getTrafficStatistics();
+    auto [agentSent, agentReceived] = agent_->getTrafficStatistics();
+    return {sent + agentSent, received + agentReceived};
+  }
+
+ private:
+  // the arrays hold a key and an indicator for each position, and generating
+  // them needs about as much memory again.
+  static const size_t kBytesPerPosition = 2 * sizeof(__m128i);
+
+  // the number of arrays of the given width that fit in the memory budget.
+  size_t getMaxArrayCount(size_t width) const;
+
+  struct PreprocessedArray {
+    // this party's share of the point position, from the least significant
+    // bit.
+    std::vector<bool> offsetShare;
+    std::vector<bool> indicators;
+    std::vector<__m128i> keys;
+  };
+
+  std::unique_ptr<ISinglePointArrayGenerator> generator_;
+  std::unique_ptr<engine::communication::IPartyCommunicationAgent> agent_;
+  size_t memoryBudget_;
+  // the preprocessed arrays of each index width.
+  std::map<size_t, std::deque<PreprocessedArray>> preprocessedArrays_;
+};
+
+} // namespace fbpcf::mpc_std_lib::oram
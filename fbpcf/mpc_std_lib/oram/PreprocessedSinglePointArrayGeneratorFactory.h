@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <memory>
+#include "fbpcf/engine/communication/IPartyCommunicationAgentFactory.h"
+#include "fbpcf/mpc_std_lib/oram/ISinglePointArrayGeneratorFactory.h"
+#include "fbpcf/mpc_std_lib/oram/PreprocessedSinglePointArrayGenerator.h"
+
+namespace fbpcf::mpc_std_lib::oram {
+
+class PreprocessedSinglePointArrayGeneratorFactory final
+    : public ISinglePointArrayGeneratorFactory {
+ public:
+  /**
+   * @param generatorFactory the factory of the generators that create the
+   * arrays in the offline phase.
+   * @param memoryBudget the approximate amount of memory the preprocessed
+   * arrays of each generator may use, in bytes.
+   */
+  PreprocessedSinglePointArrayGeneratorFactory(
+      int32_t peerId,
+      engine::communication::IPartyCommunicationAgentFactory& factory,
+      std::unique_ptr<ISinglePointArrayGeneratorFactory> generatorFactory,
+      size_t memoryBudget =
+          PreprocessedSinglePointArrayGenerator::kDefaultMemoryBudget)
+      : peerId_(peerId),
+        factory_(factory),
+        generatorFactory_(std::move(generatorFactory)),
+        memoryBudget_(memoryBudget) {}
+
+  std::unique_ptr<ISinglePointArrayGenerator> create() override {
+    return std::make_unique<PreprocessedSinglePointArrayGenerator>(
+        generatorFactory_->create(), factory_.create(peerId_), memoryBudget_);
+  }
+
+ private:
+  int32_t peerId_;
+  engine::communication::IPartyCommunicationAgentFactory& factory_;
+  std::unique_ptr<ISinglePointArrayGeneratorFactory> generatorFactory_;
+  size_t memoryBudget_;
+};
+
+} // namespace fbpcf::mpc_std_lib::oram
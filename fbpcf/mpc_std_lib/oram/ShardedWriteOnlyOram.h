@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include "fbpcf/frontend/Bit.h"
+#include "fbpcf/mpc_std_lib/oram/IWriteOnlyOram.h"
+
+namespace fbpcf::mpc_std_lib::oram {
+
+/**
+ * One shard of a write-only oram whose positions are split across several
+ * processes or hosts. Shard k holds the positions [k * 2^shardWidth,
+ * (k + 1) * 2^shardWidth) in an oram of its own, which talks to the matching
+ * shard of the other party through its own agents and scheduler. All shards
+ * receive the same shares of each batch. The high index bits, which form the
+ * top of the tree, are only compared to the shard index, and the values of
+ * writes to other shards are zeroed; the low index bits then address the
+ * positions in the shard, whose subtrees are expanded locally.
+ */
+template <typename T, int schedulerId>
+class ShardedWriteOnlyOram final : public IWriteOnlyOram<T> {
+  using Role = typename IWriteOnlyOram<T>::Role;
+  using SecBit = frontend::Bit<true, schedulerId, true>;
+
+ public:
+  /**
+   * @param shardIndex the index of this shard, the same for both parties.
+   * @param shardWidth the number of low index bits that address a position
+   * within a shard.
+   * @param shard the oram holding the positions of this shard.
+   */
+  ShardedWriteOnlyOram(
+      Role myRole,
+      size_t shardIndex,
+      size_t shardWidth,
+      std::unique_ptr<IWriteOnlyOram<T>> shard)
+      : myRole_(myRole),
+        shardIndex_(shardIndex),
+        shardWidth_(shardWidth),
+        shard_(std::move(shard)) {}
+
+  /**
+   * @inherit doc
+   * Only the positions of this shard can be read.
+   */
+  T publicRead(size_t publicIndex, Role receiver) const override {
+    return shard_->publicRead(getLocalIndex(publicIndex), receiver);
+  }
+
+  /**
+   * @inherit doc
+   * Only the positions of this shard can be read.
+   */
+  T secretRead(size_t publicIndex) const override {
+    return shard_->secretRead(getLocalIndex(publicIndex));
+  }
+
+  /**
+   * @inherit doc
+   */
+  void obliviousAddBatch(
+      const std::vector<std::vector<bool>>& indexShares,
+      const std::vector<std::vector<bool>>& values) override;
+
+  /**
+   * @inherit doc
+   */
+  std::pair<uint64_t, uint64_t> getTrafficStatistics() const override {
+    return shard_->getTrafficStatistics();
+  }
+
+ private:
+  size_t getLocalIndex(size_t publicIndex) const;
+
+  // this party's shares of whether the high index bits equal the shard index.
+  SecBit isInShard(const std::vector<std::vector<bool>>& indexShares) const;
+
+  Role myRole_;
+  size_t shardIndex_;
+  size_t shardWidth_;
+  std::unique_ptr<IWriteOnlyOram<T>> shard_;
+};
+
+} // namespace fbpcf::mpc_std_lib::oram
+
+#include "fbpcf/mpc_std_lib/oram/ShardedWriteOnlyOram_impl.h"
@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include "fbpcf/mpc_std_lib/oram/IWriteOnlyOramFactory.h"
+#include "fbpcf/mpc_std_lib/oram/ShardedWriteOnlyOram.h"
+
+namespace fbpcf::mpc_std_lib::oram {
+
+/**
+ * Create one shard of a sharded write-only oram. Every shard process creates
+ * its own factory, with a shard factory whose agents and scheduler connect to
+ * the matching shard process of the other party.
+ */
+template <typename T, int schedulerId>
+class ShardedWriteOnlyOramFactory final : public IWriteOnlyOramFactory<T> {
+ public:
+  ShardedWriteOnlyOramFactory(
+      typename IWriteOnlyOram<T>::Role myRole,
+      size_t shardIndex,
+      size_t shardCount,
+      std::unique_ptr<IWriteOnlyOramFactory<T>> shardFactory)
+      : myRole_(myRole),
+        shardIndex_(shardIndex),
+        shardCount_(shardCount),
+        shardFactory_(std::move(shardFactory)) {
+    if (shardIndex_ >= shardCount_) {
+      throw std::invalid_argument("Shard index is out of range.");
+    }
+  }
+
+  /**
+   * Create the shard of an oram of the given total size.
+   */
+  std::unique_ptr<IWriteOnlyOram<T>> create(size_t size) override {
+    auto shardWidth = getShardWidth(size);
+    return std::make_unique<ShardedWriteOnlyOram<T, schedulerId>>(
+        myRole_,
+        shardIndex_,
+        shardWidth,
+        shardFactory_->create(getShardSize(size, shardWidth)));
+  }
+
+  /**
+   * @inherit doc
+   */
+  uint32_t getMaxBatchSize(size_t size, uint8_t concurrency) override {
+    return shardFactory_->getMaxBatchSize(
+        getShardSize(size, getShardWidth(size)), concurrency);
+  }
+
+  /**
+   * The number of low index bits that address a position within a shard, such
+   * that shardCount shards of 2^shardWidth positions cover the oram. Shards
+   * have at least two positions.
+   */
+  size_t getShardWidth(size_t size) const {
+    size_t shardWidth = 1;
+    while ((shardCount_ << shardWidth) < size) {
+      shardWidth++;
+    }
+    return shardWidth;
+  }
+
+ private:
+  size_t getShardSize(size_t size, size_t shardWidth) const {
+    size_t offset = shardIndex_ << shardWidth;
+    if (offset >= size) {
+      throw std::invalid_argument("This shard has no positions.");
+    }
+    return std::min(size - offset, size_t(1) << shardWidth);
+  }
+
+  typename IWriteOnlyOram<T>::Role myRole_;
+  size_t shardIndex_;
+  size_t shardCount_;
+  std::unique_ptr<IWriteOnlyOramFactory<T>> shardFactory_;
+};
+
+} // namespace fbpcf::mpc_std_lib::oram
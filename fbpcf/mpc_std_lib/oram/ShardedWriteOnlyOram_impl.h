@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <stdexcept>
+
+namespace fbpcf::mpc_std_lib::oram {
+
+template <typename T, int schedulerId>
+size_t ShardedWriteOnlyOram<T, schedulerId>::getLocalIndex(
+    size_t publicIndex) const {
+  if ((publicIndex >> shardWidth_) != shardIndex_) {
+    throw std::runtime_error("ORAM read index is not in this shard.");
+  }
+  return publicIndex - (shardIndex_ << shardWidth_);
+}
+
+template <typename T, int schedulerId>
+void ShardedWriteOnlyOram<T, schedulerId>::obliviousAddBatch(
+    const std::vector<std::vector<bool>>& indexShares,
+    const std::vector<std::vector<bool>>& values) {
+  if (indexShares.size() < shardWidth_) {
+    throw std::runtime_error("Input index array size is too small.");
+  }
+  if ((indexShares.size() == 0) || (values.size() == 0)) {
+    throw std::runtime_error("Input cannot be empty");
+  }
+  auto highBitCount = indexShares.size() - shardWidth_;
+  if (highBitCount < 64 && (shardIndex_ >> highBitCount) != 0) {
+    // no index of this width can fall into this shard.
+    return;
+  }
+
+  std::vector<std::vector<bool>> localIndexShares(
+      indexShares.begin(), indexShares.begin() + shardWidth_);
+  if (highBitCount == 0) {
+    shard_->obliviousAddBatch(localIndexShares, values);
+    return;
+  }
+
+  // zero the values of the writes to other shards.
+  std::vector<SecBit> valueBits;
+  for (auto& item : values) {
+    auto shares = item;
+    valueBits.push_back(
+        SecBit(typename SecBit::ExtractedBit(std::move(shares))));
+  }
+  auto maskedValueBits = isInShard(indexShares) & valueBits;
+  std::vector<std::vector<bool>> maskedValues;
+  for (auto& item : maskedValueBits) {
+    maskedValues.push_back(item.extractBit().getValue());
+  }
+  shard_->obliviousAddBatch(localIndexShares, maskedValues);
+}
+
+template <typename T, int schedulerId>
+typename ShardedWriteOnlyOram<T, schedulerId>::SecBit
+ShardedWriteOnlyOram<T, schedulerId>::isInShard(
+    const std::vector<std::vector<bool>>& indexShares) const {
+  std::vector<SecBit> matches;
+  for (size_t i = shardWidth_; i < indexShares.size(); i++) {
+    auto shares = indexShares.at(i);
+    // an index bit matches a 0 bit of the shard index if it is 0, so one party
+    // flips its shares of it.
+    auto shardBit = (i - shardWidth_ < 64) &&
+        ((shardIndex_ >> (i - shardWidth_)) & 1);
+    if (!shardBit && myRole_ == Role::Alice) {
+      shares.flip();
+    }
+    matches.push_back(SecBit(typename SecBit::ExtractedBit(std::move(shares))));
+  }
+  // the AND of all matches, with a tree of logarithmic depth.
+  while (matches.size() > 1) {
+    std::vector<SecBit> next;
+    for (size_t i = 0; i + 1 < matches.size(); i += 2) {
+      next.push_back(matches.at(i) & matches.at(i + 1));
+    }
+    if (matches.size() % 2 == 1) {
+      next.push_back(std::move(matches.back()));
+    }
+    matches = std::move(next);
+  }
+  return matches.at(0);
+}
+
+} // namespace fbpcf::mpc_std_lib::oram
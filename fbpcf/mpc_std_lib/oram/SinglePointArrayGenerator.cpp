@@ -66,31 +66,37 @@ ISinglePointArrayGenerator::ArrayType SinglePointArrayGenerator::expandArray(
   std::vector<__m128i> delta0(batchSize, _mm_set_epi64x(0, 0));
   std::vector<__m128i> delta1(batchSize, _mm_set_epi64x(0, 0));
 
-  for (size_t i = 0; i < batchSize; i++) {
-    rst[i].second = expander_->expand(std::move(src[i].second));
-    for (size_t j = 0; j < rst.at(i).second.size(); j += 2) {
-      delta0[i] = _mm_xor_si128(delta0.at(i), rst.at(i).second.at(j));
-      delta1[i] = _mm_xor_si128(delta1.at(i), rst.at(i).second.at(j + 1));
+  // the trees are independent, so each thread expands a range of them.
+  util::parallelFor(batchSize, threadCount_, [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; i++) {
+      rst[i].second = expander_->expand(std::move(src[i].second));
+      for (size_t j = 0; j < rst.at(i).second.size(); j += 2) {
+        delta0[i] = _mm_xor_si128(delta0.at(i), rst.at(i).second.at(j));
+        delta1[i] = _mm_xor_si128(delta1.at(i), rst.at(i).second.at(j + 1));
+      }
     }
-  }
+  });
   auto [delta, t0, t1] =
       obliviousDeltaCalculator_->calculateDelta(delta0, delta1, indicatorShare);
-  for (size_t i = 0; i < batchSize; i++) {
-    rst[i].first = std::vector<bool>(rst.at(i).second.size());
+  util::parallelFor(batchSize, threadCount_, [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; i++) {
+      rst[i].first = std::vector<bool>(rst.at(i).second.size());
 
-    for (size_t j = 0; j < rst.at(i).second.size(); j += 2) {
-      rst[i].first[j] = engine::util::getLsb(rst.at(i).second.at(j));
-      rst[i].first[j + 1] = engine::util::getLsb(rst.at(i).second.at(j + 1));
-      if (src.at(i).first.at(j >> 1)) {
-        rst[i].first[j] = rst.at(i).first.at(j) ^ t0.at(i);
-        rst[i].first[j + 1] = rst.at(i).first.at(j + 1) ^ t1.at(i);
+      for (size_t j = 0; j < rst.at(i).second.size(); j += 2) {
+        rst[i].first[j] = engine::util::getLsb(rst.at(i).second.at(j));
+        rst[i].first[j + 1] = engine::util::getLsb(rst.at(i).second.at(j + 1));
+        if (src.at(i).first.at(j >> 1)) {
+          rst[i].first[j] = rst.at(i).first.at(j) ^ t0.at(i);
+          rst[i].first[j + 1] = rst.at(i).first.at(j + 1) ^ t1.at(i);
 
-        rst[i].second[j] = _mm_xor_si128(rst.at(i).second.at(j), delta.at(i));
-        rst[i].second[j + 1] =
-            _mm_xor_si128(rst.at(i).second.at(j + 1), delta.at(i));
+          rst[i].second[j] =
+              _mm_xor_si128(rst.at(i).second.at(j), delta.at(i));
+          rst[i].second[j + 1] =
+              _mm_xor_si128(rst.at(i).second.at(j + 1), delta.at(i));
+        }
       }
     }
-  }
+  });
   return rst;
 }
 
@@ -30,9 +30,11 @@ class SinglePointArrayGenerator final : public ISinglePointArrayGenerator {
       bool firstShare /* which value to start with when generating the
                          array, the two parties must use different values*/
       ,
-      std::unique_ptr<IObliviousDeltaCalculator> obliviousDeltaCalculator)
+      std::unique_ptr<IObliviousDeltaCalculator> obliviousDeltaCalculator,
+      size_t threadCount = 1 /* the number of threads to expand the trees*/)
       : firstShare_(firstShare),
-        obliviousDeltaCalculator_(std::move(obliviousDeltaCalculator)) {
+        obliviousDeltaCalculator_(std::move(obliviousDeltaCalculator)),
+        threadCount_(threadCount) {
     expander_ = std::make_unique<engine::util::Expander>(
         0 /* this index is not important, any PUBLIC CONSTANT works*/);
   }
@@ -56,6 +58,7 @@ class SinglePointArrayGenerator final : public ISinglePointArrayGenerator {
 
   bool firstShare_;
   std::unique_ptr<IObliviousDeltaCalculator> obliviousDeltaCalculator_;
+  size_t threadCount_;
   std::unique_ptr<engine::util::Expander> expander_;
 };
 
@@ -21,18 +21,21 @@ class SinglePointArrayGeneratorFactory final
   SinglePointArrayGeneratorFactory(
       bool firstShare,
       std::unique_ptr<IObliviousDeltaCalculatorFactory>
-          obliviousCalculatrFactory)
+          obliviousCalculatrFactory,
+      size_t threadCount = 1)
       : firstShare_(firstShare),
-        obliviousCalculatrFactory_(std::move(obliviousCalculatrFactory)) {}
+        obliviousCalculatrFactory_(std::move(obliviousCalculatrFactory)),
+        threadCount_(threadCount) {}
 
   std::unique_ptr<ISinglePointArrayGenerator> create() override {
     return std::make_unique<SinglePointArrayGenerator>(
-        firstShare_, obliviousCalculatrFactory_->create());
+        firstShare_, obliviousCalculatrFactory_->create(), threadCount_);
   }
 
  private:
   bool firstShare_;
   std::unique_ptr<IObliviousDeltaCalculatorFactory> obliviousCalculatrFactory_;
+  size_t threadCount_;
 };
 
 } // namespace fbpcf::mpc_std_lib::oram
@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "fbpcf/frontend/Bit.h"
+#include "fbpcf/frontend/BitString.h"
+#include "fbpcf/frontend/Vectorizer.h"
+#include "fbpcf/mpc_std_lib/oram/IReadWriteOram.h"
+#include "fbpcf/mpc_std_lib/shuffler/IShuffler.h"
+
+namespace fbpcf::mpc_std_lib::oram {
+
+/**
+ * A two-party square-root ORAM, following Zahur et al., "Revisiting
+ * Square-Root ORAM: Efficient Random Access in Multi-Party Computation".
+ * The values are kept, together with their logical indexes, in a secretly
+ * shuffled array that is extended with a number of dummy records. Each access
+ * scans a small stash of recently accessed records and then reveals one
+ * physical position of the shuffled array, which is either the position of
+ * the requested record or, if that record is already in the stash, the
+ * position of a fresh dummy record. Every physical position is revealed at most
+ * once between two shuffles, so the revealed positions are uniformly random.
+ * After a fixed number of accesses the stash is merged back and the array is
+ * reshuffled. The position map is itself a (smaller) square-root ORAM, or a
+ * linear scan once it is small enough.
+ */
+template <int schedulerId>
+class SquareRootOram final : public IReadWriteOram {
+  using SecBit = frontend::Bit<true, schedulerId, false>;
+  using SecBatchBit = frontend::Bit<true, schedulerId, true>;
+  using PubBatchBit = frontend::Bit<false, schedulerId, true>;
+  using SecString = frontend::BitString<true, schedulerId, true>;
+
+ public:
+  // the position map is a linear scan up to this many records.
+  static const size_t kMaxLinearPositionMapSize = 512;
+  // the number of positions stored in one value of a recursive position map.
+  static const size_t kPositionsPerBlock = 8;
+
+  /**
+   * Create an oram holding the given values. Both parties need to call this at
+   * the same time since the initial shuffle is interactive.
+   * @param valueShares this party's XOR shares of the initial values, from
+   * share batches of less significant to share batches of more significant;
+   * @param shuffler the shuffler used to rebuild the oram, shared with the
+   * recursive position maps.
+   */
+  SquareRootOram(
+      int myId,
+      int partnerId,
+      const std::vector<std::vector<bool>>& valueShares,
+      std::shared_ptr<shuffler::IShuffler<SecString>> shuffler);
+
+  /**
+   * @inherit doc
+   */
+  size_t getSize() const override {
+    return size_;
+  }
+
+  /**
+   * @inherit doc
+   */
+  std::vector<std::vector<bool>> secretReadBatch(
+      const std::vector<std::vector<bool>>& indexShares) override;
+
+  /**
+   * @inherit doc
+   */
+  void secretWriteBatch(
+      const std::vector<std::vector<bool>>& indexShares,
+      const std::vector<std::vector<bool>>& valueShares) override;
+
+ private:
+  // read the value at a secret index and optionally overwrite it. Indexes and
+  // values are this party's shares of one access, from the least significant
+  // bit.
+  std::vector<bool> access(
+      const std::vector<bool>& indexShares,
+      bool isWrite,
+      const std::vector<bool>& valueShares);
+
+  // shuffle the given records and build the position map for the next epoch.
+  void initializeEpoch(
+      std::vector<std::vector<bool>>&& idShares,
+      std::vector<std::vector<bool>>&& valueShares);
+
+  // merge the stash and all untouched records and start a new epoch.
+  void refresh();
+
+  void buildPositionMap();
+
+  std::vector<SecBit> lookupPosition(const std::vector<SecBit>& id);
+
+  // select the entry whose public key equals the secret key. entryShares are
+  // this party's shares of the entries, [bit][entry].
+  std::vector<SecBit> selectEntry(
+      const std::vector<PubBatchBit>& keys,
+      const std::vector<SecBit>& key,
+      const std::vector<std::vector<bool>>& entryShares) const;
+
+  // whether all the given bits are 0, e.g. the XOR of two equal values.
+  SecBatchBit isZero(const std::vector<SecBatchBit>& bits) const;
+
+  // whether a secret value is smaller than a public bound.
+  SecBit lessThan(const std::vector<SecBit>& value, uint64_t bound) const;
+
+  // the AND of all the given bits, computed as a tree.
+  SecBit andAll(std::vector<SecBit> bits) const;
+
+  std::vector<std::vector<bool>> shuffle(
+      const std::vector<std::vector<bool>>& shares,
+      size_t size) const;
+
+  // reveal secret bits to both parties.
+  std::vector<std::vector<bool>> open(
+      const std::vector<std::vector<bool>>& shares) const;
+
+  // this party's share of a public bit.
+  bool getConstantShare(bool v) const {
+    return myId_ < partnerId_ && v;
+  }
+
+  std::vector<PubBatchBit> getPublicKeys(size_t size, size_t width) const;
+
+  int myId_;
+  int partnerId_;
+  std::shared_ptr<shuffler::IShuffler<SecString>> shuffler_;
+
+  size_t size_;
+  size_t valueWidth_;
+  // the number of accesses between two shuffles, which is also the number of
+  // dummy records.
+  size_t period_;
+  size_t physicalSize_;
+  // the bit width of logical indexes and physical positions.
+  size_t idWidth_;
+
+  // this party's shares of the shuffled records, [bit][position].
+  std::vector<std::vector<bool>> idShares_;
+  std::vector<std::vector<bool>> valueShares_;
+  std::vector<bool> touched_;
+
+  // this party's shares of the stash, [bit][entry].
+  std::vector<std::vector<bool>> stashIdShares_;
+  std::vector<std::vector<bool>> stashValueShares_;
+  size_t accessCount_;
+
+  // this party's shares of the physical position of each logical index,
+  // [bit][index], when the position map is a linear scan.
+  std::vector<std::vector<bool>> positionShares_;
+  std::vector<PubBatchBit> positionKeys_;
+  // the recursive position map, which stores kPositionsPerBlock positions per
+  // value.
+  std::unique_ptr<SquareRootOram<schedulerId>> positionMap_;
+  std::vector<PubBatchBit> blockKeys_;
+};
+
+} // namespace fbpcf::mpc_std_lib::oram
+
+#include "fbpcf/mpc_std_lib/oram/SquareRootOram_impl.h"
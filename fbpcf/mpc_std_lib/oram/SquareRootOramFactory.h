@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <memory>
+
+#include "fbpcf/engine/util/AesPrgFactory.h"
+#include "fbpcf/mpc_std_lib/oram/IReadWriteOramFactory.h"
+#include "fbpcf/mpc_std_lib/oram/SquareRootOram.h"
+#include "fbpcf/mpc_std_lib/permuter/AsWaksmanPermuterFactory.h"
+#include "fbpcf/mpc_std_lib/shuffler/IShufflerFactory.h"
+#include "fbpcf/mpc_std_lib/shuffler/PermuteBasedShufflerFactory.h"
+
+namespace fbpcf::mpc_std_lib::oram {
+
+template <int schedulerId>
+class SquareRootOramFactory final : public IReadWriteOramFactory {
+  using SecString = frontend::BitString<true, schedulerId, true>;
+
+ public:
+  SquareRootOramFactory(
+      int myId,
+      int partnerId,
+      std::unique_ptr<shuffler::IShufflerFactory<SecString>> shufflerFactory)
+      : myId_(myId),
+        partnerId_(partnerId),
+        shufflerFactory_(std::move(shufflerFactory)) {}
+
+  std::unique_ptr<IReadWriteOram> create(
+      const std::vector<std::vector<bool>>& valueShares) override {
+    return std::make_unique<SquareRootOram<schedulerId>>(
+        myId_, partnerId_, valueShares, shufflerFactory_->create());
+  }
+
+ private:
+  int myId_;
+  int partnerId_;
+  std::unique_ptr<shuffler::IShufflerFactory<SecString>> shufflerFactory_;
+};
+
+template <int schedulerId>
+std::unique_ptr<IReadWriteOramFactory> getSecureSquareRootOramFactory(
+    int myId,
+    int partnerId) {
+  return std::make_unique<SquareRootOramFactory<schedulerId>>(
+      myId,
+      partnerId,
+      std::make_unique<shuffler::PermuteBasedShufflerFactory<
+          frontend::BitString<true, schedulerId, true>>>(
+          myId,
+          partnerId,
+          std::make_unique<permuter::AsWaksmanPermuterFactory<
+              std::vector<bool>,
+              schedulerId>>(myId, partnerId),
+          std::make_unique<engine::util::AesPrgFactory>()));
+}
+
+} // namespace fbpcf::mpc_std_lib::oram
@@ -0,0 +1,543 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cmath>
+#include <stdexcept>
+
+// included for clangd resolution. Should not execute during compilation
+#include "fbpcf/mpc_std_lib/oram/SquareRootOram.h"
+
+namespace fbpcf::mpc_std_lib::oram {
+
+namespace detail {
+
+// the number of bits needed to represent every value smaller than size.
+inline size_t getBitWidth(size_t size) {
+  size_t width = 1;
+  while (width < 64 && (uint64_t(1) << width) < size) {
+    width++;
+  }
+  return width;
+}
+
+template <int schedulerId>
+frontend::Bit<true, schedulerId, false> toSecretBit(bool share) {
+  return frontend::Bit<true, schedulerId, false>(
+      typename frontend::Bit<true, schedulerId, false>::ExtractedBit(share));
+}
+
+template <int schedulerId>
+frontend::Bit<true, schedulerId, true> toSecretBatch(
+    const std::vector<bool>& shares) {
+  return frontend::Bit<true, schedulerId, true>(
+      typename frontend::Bit<true, schedulerId, true>::ExtractedBit(shares));
+}
+
+template <int schedulerId>
+std::vector<frontend::Bit<true, schedulerId, true>> toSecretBatch(
+    const std::vector<std::vector<bool>>& shares) {
+  std::vector<frontend::Bit<true, schedulerId, true>> rst;
+  rst.reserve(shares.size());
+  for (auto& plane : shares) {
+    rst.push_back(toSecretBatch<schedulerId>(plane));
+  }
+  return rst;
+}
+
+} // namespace detail
+
+template <int schedulerId>
+SquareRootOram<schedulerId>::SquareRootOram(
+    int myId,
+    int partnerId,
+    const std::vector<std::vector<bool>>& valueShares,
+    std::shared_ptr<shuffler::IShuffler<SecString>> shuffler)
+    : myId_(myId),
+      partnerId_(partnerId),
+      shuffler_(std::move(shuffler)),
+      valueWidth_(valueShares.size()) {
+  if (valueWidth_ == 0 || valueShares.at(0).empty()) {
+    throw std::invalid_argument("Can't create an empty oram.");
+  }
+  size_ = valueShares.at(0).size();
+  for (auto& plane : valueShares) {
+    if (plane.size() != size_) {
+      throw std::invalid_argument("All values need to have the same width.");
+    }
+  }
+  // balance the stash scans against the amortized cost of reshuffling.
+  period_ = std::max<size_t>(
+      1, std::ceil(std::sqrt(size_ * std::max(1.0, std::log2(size_)))));
+  physicalSize_ = size_ + period_;
+  idWidth_ = detail::getBitWidth(physicalSize_);
+
+  // the dummy records have the indexes after the real ones and value 0.
+  std::vector<std::vector<bool>> idShares(
+      idWidth_, std::vector<bool>(physicalSize_));
+  std::vector<std::vector<bool>> records(
+      valueWidth_, std::vector<bool>(physicalSize_, false));
+  for (size_t i = 0; i < physicalSize_; i++) {
+    for (size_t j = 0; j < idWidth_; j++) {
+      idShares[j][i] = getConstantShare((i >> j) & 1);
+    }
+  }
+  for (size_t j = 0; j < valueWidth_; j++) {
+    std::copy(
+        valueShares.at(j).begin(),
+        valueShares.at(j).end(),
+        records[j].begin());
+  }
+
+  if (physicalSize_ <= kMaxLinearPositionMapSize) {
+    positionKeys_ = getPublicKeys(physicalSize_, idWidth_);
+  } else {
+    size_t blockBits = detail::getBitWidth(kPositionsPerBlock);
+    blockKeys_ = getPublicKeys(kPositionsPerBlock, blockBits);
+  }
+  initializeEpoch(std::move(idShares), std::move(records));
+}
+
+template <int schedulerId>
+std::vector<std::vector<bool>> SquareRootOram<schedulerId>::secretReadBatch(
+    const std::vector<std::vector<bool>>& indexShares) {
+  if (indexShares.empty()) {
+    throw std::invalid_argument("Index can't be empty.");
+  }
+  auto batchSize = indexShares.at(0).size();
+  std::vector<std::vector<bool>> rst(
+      valueWidth_, std::vector<bool>(batchSize));
+  std::vector<bool> index(indexShares.size());
+  for (size_t i = 0; i < batchSize; i++) {
+    for (size_t j = 0; j < index.size(); j++) {
+      index[j] = indexShares.at(j).at(i);
+    }
+    auto value = access(index, false, {});
+    for (size_t j = 0; j < valueWidth_; j++) {
+      rst[j][i] = value.at(j);
+    }
+  }
+  return rst;
+}
+
+template <int schedulerId>
+void SquareRootOram<schedulerId>::secretWriteBatch(
+    const std::vector<std::vector<bool>>& indexShares,
+    const std::vector<std::vector<bool>>& valueShares) {
+  if (indexShares.empty()) {
+    throw std::invalid_argument("Index can't be empty.");
+  }
+  if (valueShares.size() != valueWidth_) {
+    throw std::invalid_argument("Value width mismatch.");
+  }
+  auto batchSize = indexShares.at(0).size();
+  std::vector<bool> index(indexShares.size());
+  std::vector<bool> value(valueWidth_);
+  for (size_t i = 0; i < batchSize; i++) {
+    for (size_t j = 0; j < index.size(); j++) {
+      index[j] = indexShares.at(j).at(i);
+    }
+    for (size_t j = 0; j < valueWidth_; j++) {
+      value[j] = valueShares.at(j).at(i);
+    }
+    access(index, true, value);
+  }
+}
+
+template <int schedulerId>
+std::vector<bool> SquareRootOram<schedulerId>::access(
+    const std::vector<bool>& indexShares,
+    bool isWrite,
+    const std::vector<bool>& valueShares) {
+  auto stashSize = accessCount_;
+  auto dummyId = size_ + accessCount_;
+  std::vector<SecBit> dummy(idWidth_);
+  for (size_t i = 0; i < idWidth_; i++) {
+    dummy[i] = detail::toSecretBit<schedulerId>(
+        getConstantShare((dummyId >> i) & 1));
+  }
+
+  std::vector<SecBit> index(indexShares.size());
+  for (size_t i = 0; i < index.size(); i++) {
+    index[i] = detail::toSecretBit<schedulerId>(indexShares.at(i));
+  }
+  // a valid index is smaller than size_, so it fits in idWidth_ bits.
+  std::vector<SecBit> id(idWidth_);
+  for (size_t i = 0; i < idWidth_; i++) {
+    id[i] = i < index.size()
+        ? index.at(i)
+        : detail::toSecretBit<schedulerId>(getConstantShare(false));
+  }
+  // an index that is out of range is treated like a stash hit so that it only
+  // touches a dummy record. It is valid iff its low idWidth_ bits are smaller
+  // than size_ and all of its higher bits are 0.
+  bool checkRange =
+      index.size() >= 64 || (uint64_t(1) << index.size()) > size_;
+  auto valid = detail::toSecretBit<schedulerId>(getConstantShare(true));
+  if (checkRange) {
+    std::vector<SecBit> lowBits(
+        index.begin(), index.begin() + std::min(index.size(), idWidth_));
+    std::vector<SecBit> conditions({lessThan(lowBits, size_)});
+    for (size_t i = idWidth_; i < index.size(); i++) {
+      conditions.push_back(!index.at(i));
+    }
+    valid = andAll(conditions);
+  }
+
+  auto found = detail::toSecretBit<schedulerId>(getConstantShare(false));
+  std::vector<SecBit> stashValue(valueWidth_, found);
+  SecBatchBit match;
+  if (stashSize > 0) {
+    std::vector<SecBatchBit> stashIdToId(idWidth_);
+    for (size_t i = 0; i < idWidth_; i++) {
+      stashIdToId[i] =
+          detail::toSecretBatch<schedulerId>(stashIdShares_.at(i)) ^
+          frontend::broadcast(id.at(i), stashSize);
+    }
+    match = isZero(stashIdToId);
+    if (checkRange) {
+      match = match & frontend::broadcast(valid, stashSize);
+    }
+    found = frontend::xorAll(match);
+    auto selected =
+        match & detail::toSecretBatch<schedulerId>(stashValueShares_);
+    for (size_t i = 0; i < valueWidth_; i++) {
+      stashValue[i] = frontend::xorAll(selected.at(i));
+    }
+  }
+
+  // look up the requested record, or the next dummy record if the requested
+  // one is in the stash or doesn't exist.
+  std::vector<SecBit> idToDummy(idWidth_);
+  for (size_t i = 0; i < idWidth_; i++) {
+    idToDummy[i] = id.at(i) ^ dummy.at(i);
+  }
+  auto redirected = (found | !valid) & idToDummy;
+  std::vector<SecBit> target(idWidth_);
+  for (size_t i = 0; i < idWidth_; i++) {
+    target[i] = id.at(i) ^ redirected.at(i);
+  }
+  auto position = lookupPosition(target);
+  std::vector<std::vector<bool>> positionShares(idWidth_);
+  for (size_t i = 0; i < idWidth_; i++) {
+    positionShares[i] = {position.at(i).extractBit().getValue()};
+  }
+  auto openedPosition = open(positionShares);
+  size_t physicalPosition = 0;
+  for (size_t i = 0; i < idWidth_; i++) {
+    physicalPosition |= size_t(openedPosition.at(i).at(0)) << i;
+  }
+  if (physicalPosition >= physicalSize_ || touched_.at(physicalPosition)) {
+    throw std::runtime_error(
+        "Failed to access the oram, the position was already touched.");
+  }
+  touched_[physicalPosition] = true;
+
+  std::vector<SecBit> physicalToStash(valueWidth_);
+  for (size_t i = 0; i < valueWidth_; i++) {
+    physicalToStash[i] =
+        detail::toSecretBit<schedulerId>(
+            valueShares_.at(i).at(physicalPosition)) ^
+        stashValue.at(i);
+  }
+  auto foundValue = found & physicalToStash;
+  std::vector<SecBit> value(valueWidth_);
+  std::vector<bool> rst(valueWidth_);
+  for (size_t i = 0; i < valueWidth_; i++) {
+    value[i] = physicalToStash.at(i) ^ stashValue.at(i) ^ foundValue.at(i);
+    rst[i] = value.at(i).extractBit().getValue();
+  }
+
+  if (isWrite) {
+    if (valueShares.size() != valueWidth_) {
+      throw std::invalid_argument("Value width mismatch.");
+    }
+    std::vector<SecBit> valueToNewValue(valueWidth_);
+    for (size_t i = 0; i < valueWidth_; i++) {
+      valueToNewValue[i] =
+          value.at(i) ^ detail::toSecretBit<schedulerId>(valueShares.at(i));
+    }
+    auto written = valid & valueToNewValue;
+    for (size_t i = 0; i < valueWidth_; i++) {
+      value[i] = value.at(i) ^ written.at(i);
+    }
+  }
+
+  // the old stash entry of this index now stands for the dummy record that
+  // was just touched, and the accessed record moves to the end of the stash.
+  if (stashSize > 0) {
+    std::vector<SecBatchBit> stashIdToDummy(idWidth_);
+    for (size_t i = 0; i < idWidth_; i++) {
+      stashIdToDummy[i] = detail::toSecretBatch<schedulerId>(
+                              stashIdShares_.at(i)) ^
+          frontend::broadcast(dummy.at(i), stashSize);
+    }
+    auto relabeled = match & stashIdToDummy;
+    for (size_t i = 0; i < idWidth_; i++) {
+      auto shares = relabeled.at(i).extractBit().getValue();
+      for (size_t j = 0; j < stashSize; j++) {
+        stashIdShares_[i][j] = stashIdShares_[i][j] ^ shares.at(j);
+      }
+    }
+  }
+  auto invalidToDummy = !valid & idToDummy;
+  for (size_t i = 0; i < idWidth_; i++) {
+    stashIdShares_[i].push_back(
+        (id.at(i) ^ invalidToDummy.at(i)).extractBit().getValue());
+  }
+  for (size_t i = 0; i < valueWidth_; i++) {
+    stashValueShares_[i].push_back(value.at(i).extractBit().getValue());
+  }
+
+  accessCount_++;
+  if (accessCount_ == period_) {
+    refresh();
+  }
+  return rst;
+}
+
+template <int schedulerId>
+void SquareRootOram<schedulerId>::initializeEpoch(
+    std::vector<std::vector<bool>>&& idShares,
+    std::vector<std::vector<bool>>&& valueShares) {
+  auto records = std::move(idShares);
+  records.insert(
+      records.end(),
+      std::make_move_iterator(valueShares.begin()),
+      std::make_move_iterator(valueShares.end()));
+  records = shuffle(records, physicalSize_);
+  idShares_ = std::vector<std::vector<bool>>(
+      std::make_move_iterator(records.begin()),
+      std::make_move_iterator(records.begin() + idWidth_));
+  valueShares_ = std::vector<std::vector<bool>>(
+      std::make_move_iterator(records.begin() + idWidth_),
+      std::make_move_iterator(records.end()));
+
+  buildPositionMap();
+
+  touched_ = std::vector<bool>(physicalSize_, false);
+  stashIdShares_ = std::vector<std::vector<bool>>(idWidth_);
+  stashValueShares_ = std::vector<std::vector<bool>>(valueWidth_);
+  accessCount_ = 0;
+}
+
+template <int schedulerId>
+void SquareRootOram<schedulerId>::refresh() {
+  // every touched record is represented by exactly one stash entry.
+  auto idShares = std::move(stashIdShares_);
+  auto valueShares = std::move(stashValueShares_);
+  for (size_t i = 0; i < physicalSize_; i++) {
+    if (touched_.at(i)) {
+      continue;
+    }
+    for (size_t j = 0; j < idWidth_; j++) {
+      idShares[j].push_back(idShares_.at(j).at(i));
+    }
+    for (size_t j = 0; j < valueWidth_; j++) {
+      valueShares[j].push_back(valueShares_.at(j).at(i));
+    }
+  }
+  initializeEpoch(std::move(idShares), std::move(valueShares));
+}
+
+template <int schedulerId>
+void SquareRootOram<schedulerId>::buildPositionMap() {
+  // shuffle the (index, position) pairs once more; the indexes are then in a
+  // uniformly random order and can be revealed to place the positions.
+  auto pairs = idShares_;
+  for (size_t i = 0; i < idWidth_; i++) {
+    std::vector<bool> plane(physicalSize_);
+    for (size_t j = 0; j < physicalSize_; j++) {
+      plane[j] = getConstantShare((j >> i) & 1);
+    }
+    pairs.push_back(std::move(plane));
+  }
+  pairs = shuffle(pairs, physicalSize_);
+  auto ids = open(std::vector<std::vector<bool>>(
+      pairs.begin(), pairs.begin() + idWidth_));
+
+  std::vector<std::vector<bool>> positionShares(
+      idWidth_, std::vector<bool>(physicalSize_));
+  std::vector<bool> placed(physicalSize_, false);
+  for (size_t i = 0; i < physicalSize_; i++) {
+    size_t id = 0;
+    for (size_t j = 0; j < idWidth_; j++) {
+      id |= size_t(ids.at(j).at(i)) << j;
+    }
+    if (id >= physicalSize_ || placed.at(id)) {
+      throw std::runtime_error(
+          "Failed to build the position map, the indexes are not unique.");
+    }
+    placed[id] = true;
+    for (size_t j = 0; j < idWidth_; j++) {
+      positionShares[j][id] = pairs.at(idWidth_ + j).at(i);
+    }
+  }
+
+  if (physicalSize_ <= kMaxLinearPositionMapSize) {
+    positionShares_ = std::move(positionShares);
+    return;
+  }
+  auto blockCount =
+      (physicalSize_ + kPositionsPerBlock - 1) / kPositionsPerBlock;
+  std::vector<std::vector<bool>> blocks(
+      kPositionsPerBlock * idWidth_, std::vector<bool>(blockCount, false));
+  for (size_t i = 0; i < physicalSize_; i++) {
+    for (size_t j = 0; j < idWidth_; j++) {
+      blocks[(i % kPositionsPerBlock) * idWidth_ + j][i / kPositionsPerBlock] =
+          positionShares.at(j).at(i);
+    }
+  }
+  positionMap_ = std::make_unique<SquareRootOram<schedulerId>>(
+      myId_, partnerId_, blocks, shuffler_);
+}
+
+template <int schedulerId>
+std::vector<typename SquareRootOram<schedulerId>::SecBit>
+SquareRootOram<schedulerId>::lookupPosition(const std::vector<SecBit>& id) {
+  if (positionMap_ == nullptr) {
+    return selectEntry(positionKeys_, id, positionShares_);
+  }
+  auto blockBits = blockKeys_.size();
+  std::vector<bool> blockIndex(idWidth_ - blockBits);
+  for (size_t i = 0; i < blockIndex.size(); i++) {
+    blockIndex[i] = id.at(blockBits + i).extractBit().getValue();
+  }
+  auto block = positionMap_->access(blockIndex, false, {});
+  std::vector<std::vector<bool>> entryShares(
+      idWidth_, std::vector<bool>(kPositionsPerBlock));
+  for (size_t i = 0; i < kPositionsPerBlock; i++) {
+    for (size_t j = 0; j < idWidth_; j++) {
+      entryShares[j][i] = block.at(i * idWidth_ + j);
+    }
+  }
+  return selectEntry(
+      blockKeys_,
+      std::vector<SecBit>(id.begin(), id.begin() + blockBits),
+      entryShares);
+}
+
+template <int schedulerId>
+std::vector<typename SquareRootOram<schedulerId>::SecBit>
+SquareRootOram<schedulerId>::selectEntry(
+    const std::vector<PubBatchBit>& keys,
+    const std::vector<SecBit>& key,
+    const std::vector<std::vector<bool>>& entryShares) const {
+  auto size = entryShares.at(0).size();
+  std::vector<SecBatchBit> keysToKey(keys.size());
+  for (size_t i = 0; i < keys.size(); i++) {
+    keysToKey[i] = keys.at(i) ^ frontend::broadcast(key.at(i), size);
+  }
+  auto indicator = isZero(keysToKey);
+  auto selected = indicator & detail::toSecretBatch<schedulerId>(entryShares);
+  std::vector<SecBit> rst(selected.size());
+  for (size_t i = 0; i < selected.size(); i++) {
+    rst[i] = frontend::xorAll(selected.at(i));
+  }
+  return rst;
+}
+
+template <int schedulerId>
+typename SquareRootOram<schedulerId>::SecBatchBit
+SquareRootOram<schedulerId>::isZero(
+    const std::vector<SecBatchBit>& bits) const {
+  std::vector<SecBatchBit> level(bits.size());
+  for (size_t i = 0; i < bits.size(); i++) {
+    level[i] = !bits.at(i);
+  }
+  while (level.size() > 1) {
+    std::vector<SecBatchBit> next;
+    for (size_t i = 0; i + 1 < level.size(); i += 2) {
+      next.push_back(level.at(i) & level.at(i + 1));
+    }
+    if (level.size() % 2 == 1) {
+      next.push_back(std::move(level.back()));
+    }
+    level = std::move(next);
+  }
+  return level.at(0);
+}
+
+template <int schedulerId>
+typename SquareRootOram<schedulerId>::SecBit
+SquareRootOram<schedulerId>::andAll(std::vector<SecBit> bits) const {
+  while (bits.size() > 1) {
+    std::vector<SecBit> next;
+    for (size_t i = 0; i + 1 < bits.size(); i += 2) {
+      next.push_back(bits.at(i) & bits.at(i + 1));
+    }
+    if (bits.size() % 2 == 1) {
+      next.push_back(std::move(bits.back()));
+    }
+    bits = std::move(next);
+  }
+  return bits.at(0);
+}
+
+template <int schedulerId>
+typename SquareRootOram<schedulerId>::SecBit
+SquareRootOram<schedulerId>::lessThan(
+    const std::vector<SecBit>& value,
+    uint64_t bound) const {
+  // compare from the least significant bit, a more significant bit decides
+  // unless both bits are the same.
+  auto rst = detail::toSecretBit<schedulerId>(getConstantShare(false));
+  for (size_t i = 0; i < value.size(); i++) {
+    if ((bound >> i) & 1) {
+      rst = !(value.at(i) & !rst);
+    } else {
+      rst = !value.at(i) & rst;
+    }
+  }
+  return rst;
+}
+
+template <int schedulerId>
+std::vector<std::vector<bool>> SquareRootOram<schedulerId>::shuffle(
+    const std::vector<std::vector<bool>>& shares,
+    size_t size) const {
+  SecString records{typename SecString::ExtractedString(shares)};
+  auto shuffled = shuffler_->shuffle(records, size).extractStringShare();
+  std::vector<std::vector<bool>> rst(shuffled.size());
+  for (size_t i = 0; i < rst.size(); i++) {
+    rst[i] = shuffled[i].getValue();
+  }
+  return rst;
+}
+
+template <int schedulerId>
+std::vector<std::vector<bool>> SquareRootOram<schedulerId>::open(
+    const std::vector<std::vector<bool>>& shares) const {
+  auto firstParty = std::min(myId_, partnerId_);
+  auto secondParty = std::max(myId_, partnerId_);
+  std::vector<std::vector<bool>> rst(shares.size());
+  for (size_t i = 0; i < shares.size(); i++) {
+    auto bit = detail::toSecretBatch<schedulerId>(shares.at(i));
+    auto toFirstParty = bit.openToParty(firstParty);
+    auto toSecondParty = bit.openToParty(secondParty);
+    rst[i] = myId_ == firstParty ? toFirstParty.getValue()
+                                 : toSecondParty.getValue();
+  }
+  return rst;
+}
+
+template <int schedulerId>
+std::vector<typename SquareRootOram<schedulerId>::PubBatchBit>
+SquareRootOram<schedulerId>::getPublicKeys(size_t size, size_t width) const {
+  std::vector<PubBatchBit> rst(width);
+  for (size_t i = 0; i < width; i++) {
+    std::vector<bool> plane(size);
+    for (size_t j = 0; j < size; j++) {
+      plane[j] = (j >> i) & 1;
+    }
+    rst[i] = PubBatchBit(plane);
+  }
+  return rst;
+}
+
+} // namespace fbpcf::mpc_std_lib::oram
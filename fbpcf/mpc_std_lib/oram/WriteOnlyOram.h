@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <emmintrin.h>
 #include <memory>
 #include "fbpcf/engine/communication/IPartyCommunicationAgent.h"
 #include "fbpcf/mpc_std_lib/oram/ISinglePointArrayGenerator.h"
@@ -20,17 +21,31 @@ class WriteOnlyOram final : public IWriteOnlyOram<T> {
   using Role = typename IWriteOnlyOram<T>::Role;
 
  public:
+  // the default memory budget of obliviousAddBatch, in bytes.
+  static const size_t kDefaultMemoryBudget = size_t(1) << 30;
+
+  /**
+   * @param memoryBudget the approximate amount of memory obliviousAddBatch may
+   * use for the masks of the writes, in bytes. Larger batches are processed
+   * in tiles that fit this budget.
+   * @param threadCount the number of threads used to generate and accumulate
+   * the masks.
+   */
   WriteOnlyOram(
       Role myRole,
       size_t size,
       std::unique_ptr<engine::communication::IPartyCommunicationAgent> agent,
       std::unique_ptr<ISinglePointArrayGenerator> generator,
-      std::unique_ptr<IDifferenceCalculator<T>> calculator)
+      std::unique_ptr<IDifferenceCalculator<T>> calculator,
+      size_t memoryBudget = kDefaultMemoryBudget,
+      size_t threadCount = 1)
       : myRole_(myRole),
         size_(size),
         agent_(std::move(agent)),
         generator_(std::move(generator)),
         calculator_(std::move(calculator)),
+        memoryBudget_(memoryBudget),
+        threadCount_(threadCount),
         memory_(size_, T(0)) {}
 
   /**
@@ -64,15 +79,32 @@ class WriteOnlyOram final : public IWriteOnlyOram<T> {
   }
 
  private:
-  std::vector<std::vector<T>> generateMasks(
+  // the single point arrays hold a key and an indicator for each position, and
+  // generating them needs about as much memory again.
+  static const size_t kBytesPerPosition = 2 * sizeof(__m128i);
+  // threads own ranges of memory_ that start at multiples of this many
+  // elements. For the value types used here (e.g. uint32_t or
+  // AggregationValue) that is a multiple of the cache line size, which keeps
+  // threads from contending on the same lines.
+  static const size_t kAlignment = 64;
+
+  // the number of writes whose masks fit in the memory budget at once.
+  size_t getTileSize() const {
+    return std::max<size_t>(1, memoryBudget_ / (size_ * kBytesPerPosition));
+  }
+
+  // generate the masks of a batch of writes and add them to memory_ directly.
+  void accumulateMasks(
       const std::vector<std::vector<bool>>& indexShares,
-      const std::vector<std::vector<bool>>& values) const;
+      const std::vector<std::vector<bool>>& values);
 
   Role myRole_;
   size_t size_;
   std::unique_ptr<engine::communication::IPartyCommunicationAgent> agent_;
   std::unique_ptr<ISinglePointArrayGenerator> generator_;
   std::unique_ptr<IDifferenceCalculator<T>> calculator_;
+  size_t memoryBudget_;
+  size_t threadCount_;
 
   std::vector<T> memory_;
 };
@@ -29,12 +29,16 @@ class WriteOnlyOramFactory final : public IWriteOnlyOramFactory<T> {
       std::unique_ptr<ISinglePointArrayGeneratorFactory>
           singlePointArrayFactory,
       std::unique_ptr<IDifferenceCalculatorFactory<T>>
-          differenceCalculatorFactory)
+          differenceCalculatorFactory,
+      size_t memoryBudget = WriteOnlyOram<T>::kDefaultMemoryBudget,
+      size_t threadCount = 1)
       : myRole_(myRole),
         peerId_(peerId),
         factory_(factory),
         singlePointArrayFactory_(std::move(singlePointArrayFactory)),
-        differenceCalculatorFactory_(std::move(differenceCalculatorFactory)) {}
+        differenceCalculatorFactory_(std::move(differenceCalculatorFactory)),
+        memoryBudget_(memoryBudget),
+        threadCount_(threadCount) {}
 
   std::unique_ptr<IWriteOnlyOram<T>> create(size_t size) override {
     return std::make_unique<WriteOnlyOram<T>>(
@@ -42,7 +46,9 @@ class WriteOnlyOramFactory final : public IWriteOnlyOramFactory<T> {
         size,
         factory_.create(peerId_),
         singlePointArrayFactory_->create(),
-        differenceCalculatorFactory_->create());
+        differenceCalculatorFactory_->create(),
+        memoryBudget_,
+        threadCount_);
   }
 
   /**
@@ -65,6 +71,8 @@ class WriteOnlyOramFactory final : public IWriteOnlyOramFactory<T> {
   engine::communication::IPartyCommunicationAgentFactory& factory_;
   std::unique_ptr<ISinglePointArrayGeneratorFactory> singlePointArrayFactory_;
   std::unique_ptr<IDifferenceCalculatorFactory<T>> differenceCalculatorFactory_;
+  size_t memoryBudget_;
+  size_t threadCount_;
 
   // The formula for the batch size is only valid with concurrency at most 4,
   // where we choose 4 because we use an AWS container with 4 vCPUs.
@@ -80,7 +88,9 @@ std::unique_ptr<IWriteOnlyOramFactory<T>> getSecureWriteOnlyOramFactory(
     bool amIParty0,
     int32_t party0Id,
     int32_t party1Id,
-    engine::communication::IPartyCommunicationAgentFactory& factory) {
+    engine::communication::IPartyCommunicationAgentFactory& factory,
+    size_t memoryBudget = WriteOnlyOram<T>::kDefaultMemoryBudget,
+    size_t threadCount = 1) {
   return std::make_unique<WriteOnlyOramFactory<T>>(
       amIParty0 ? IWriteOnlyOram<T>::Role::Alice : IWriteOnlyOram<T>::Role::Bob,
       amIParty0 ? party1Id : party0Id,
@@ -88,10 +98,13 @@ std::unique_ptr<IWriteOnlyOramFactory<T>> getSecureWriteOnlyOramFactory(
       std::make_unique<SinglePointArrayGeneratorFactory>(
           amIParty0,
           std::make_unique<ObliviousDeltaCalculatorFactory<schedulerId>>(
-              amIParty0, party0Id, party1Id)),
+              amIParty0, party0Id, party1Id),
+          threadCount),
       std::make_unique<
           DifferenceCalculatorFactory<T, indicatorSumWidth, schedulerId>>(
-          amIParty0, party0Id, party1Id));
+          amIParty0, party0Id, party1Id),
+      memoryBudget,
+      threadCount);
 }
 
 } // namespace fbpcf::mpc_std_lib::oram
@@ -7,7 +7,9 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cstddef>
+#include <mutex>
 #include <stdexcept>
 #include "fbpcf/mpc_std_lib/util/util.h"
 
@@ -59,59 +61,101 @@ void WriteOnlyOram<T>::obliviousAddBatch(
       throw std::runtime_error("Input size is inconsistent!");
     }
   }
-  auto masks = generateMasks(indexShares, values);
-  for (auto& item : masks) {
-    if (item.size() != size_) {
-      throw std::runtime_error("unexpected mask size");
+  // process the writes in tiles so that only the masks of one tile are in
+  // memory at a time.
+  auto tileSize = getTileSize();
+  if (batchSize <= tileSize) {
+    accumulateMasks(indexShares, values);
+    return;
+  }
+  std::vector<std::vector<bool>> indexTile(indexShares.size());
+  std::vector<std::vector<bool>> valueTile(values.size());
+  for (size_t start = 0; start < batchSize; start += tileSize) {
+    auto end = std::min(start + tileSize, batchSize);
+    for (size_t i = 0; i < indexShares.size(); i++) {
+      indexTile[i].assign(
+          indexShares[i].begin() + start, indexShares[i].begin() + end);
     }
-    for (size_t i = 0; i < size_; i++) {
-      // a vector of T may not support memory_[i]+= item.at(i), e.g. T = bool
-      memory_[i] = memory_.at(i) + item.at(i);
+    for (size_t i = 0; i < values.size(); i++) {
+      valueTile[i].assign(values[i].begin() + start, values[i].begin() + end);
     }
+    accumulateMasks(indexTile, valueTile);
   }
 }
 
 template <typename T>
-std::vector<std::vector<T>> WriteOnlyOram<T>::generateMasks(
+void WriteOnlyOram<T>::accumulateMasks(
     const std::vector<std::vector<bool>>& indexShares,
-    const std::vector<std::vector<bool>>& values) const {
+    const std::vector<std::vector<bool>>& values) {
   size_t batchSize = values.at(0).size();
 
   auto indicatorKeyPairs =
       generator_->generateSinglePointArrays(indexShares, size_);
+  if (indicatorKeyPairs.size() != batchSize) {
+    throw std::runtime_error("unexpected mask size");
+  }
 
-  std::vector<std::vector<T>> rst(batchSize, std::vector<T>(size_));
-  std::vector<uint32_t> indicatorShares(batchSize);
-  std::vector<T> subtrahendShares(batchSize);
-
-  for (size_t i = 0; i < batchSize; i++) {
-    indicatorShares[i] = 0;
-    subtrahendShares[i] = T(0);
-
-    // We want to compute the difference (between two parties) of
-    // subtrahendShares and indicatorShares  at the shared-index-position.
-    // However we don't know the secret index. So we calculate the difference of
-    // the sums and obliviously pick the ONLY one that differs between two
-    // parties.
-    for (size_t j = 0; j < size_; j++) {
-      rst[i][j] = util::Adapters<T>::generateFromKey(
-          indicatorKeyPairs.at(i).second.at(j));
-      subtrahendShares[i] = subtrahendShares[i] + rst.at(i).at(j);
-      indicatorShares[i] += indicatorKeyPairs.at(i).first.at(j);
+  for (auto& [indicators, keys] : indicatorKeyPairs) {
+    if (indicators.size() != size_ || keys.size() != size_) {
+      throw std::runtime_error("unexpected mask size");
     }
   }
 
+  // We want to compute the difference (between two parties) of
+  // subtrahendShares and indicatorShares  at the shared-index-position.
+  // However we don't know the secret index. So we calculate the difference of
+  // the sums and obliviously pick the ONLY one that differs between two
+  // parties.
+  // Each thread owns a range of positions of memory_ and sums up its own part
+  // of the shares, which are then added to the totals.
+  std::vector<uint32_t> indicatorShares(batchSize, 0);
+  std::vector<T> subtrahendShares(batchSize, T(0));
+  std::mutex sharesMutex;
+  util::parallelFor(
+      size_,
+      threadCount_,
+      [&](size_t begin, size_t end) {
+        std::vector<uint32_t> partialIndicatorShares(batchSize, 0);
+        std::vector<T> partialSubtrahendShares(batchSize, T(0));
+        for (size_t i = 0; i < batchSize; i++) {
+          auto& [indicators, keys] = indicatorKeyPairs.at(i);
+          // convert the keys to masks and add them to memory in one pass.
+          partialSubtrahendShares[i] = partialSubtrahendShares.at(i) +
+              util::BulkAdapters<T>::addMasksFromKeys(
+                  keys.data() + begin, end - begin, memory_.data() + begin);
+          for (size_t j = begin; j < end; j++) {
+            partialIndicatorShares[i] += indicators.at(j);
+          }
+        }
+        std::lock_guard<std::mutex> lock(sharesMutex);
+        for (size_t i = 0; i < batchSize; i++) {
+          indicatorShares[i] += partialIndicatorShares.at(i);
+          subtrahendShares[i] =
+              subtrahendShares.at(i) + partialSubtrahendShares.at(i);
+        }
+      },
+      kAlignment);
+  // the keys are no longer needed, only the indicators are.
+  for (auto& item : indicatorKeyPairs) {
+    std::vector<__m128i>().swap(item.second);
+  }
+
   auto difference = calculator_->calculateDifferenceBatch(
       indicatorShares, values, subtrahendShares);
-  for (size_t i = 0; i < batchSize; i++) {
-    for (size_t j = 0; j < size_; j++) {
-      bool indicator = indicatorKeyPairs.at(i).first.at(j);
-      if (indicator) {
-        rst[i][j] = rst[i][j] + difference.at(i);
-      }
-    }
-  }
-  return rst;
+  util::parallelFor(
+      size_,
+      threadCount_,
+      [&](size_t begin, size_t end) {
+        for (size_t i = 0; i < batchSize; i++) {
+          auto& indicators = indicatorKeyPairs.at(i).first;
+          for (size_t j = begin; j < end; j++) {
+            if (indicators.at(j)) {
+              memory_[j] = memory_.at(j) + difference.at(i);
+            }
+          }
+        }
+      },
+      kAlignment);
 }
 
 } // namespace fbpcf::mpc_std_lib::oram
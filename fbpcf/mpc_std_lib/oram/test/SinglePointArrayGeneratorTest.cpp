@@ -15,6 +15,7 @@
 #include <future>
 #include <memory>
 #include <random>
+#include <stdexcept>
 
 #include "fbpcf/engine/communication/test/AgentFactoryCreationHelper.h"
 #include "fbpcf/mpc_std_lib/oram/DummyObliviousDeltaCalculatorFactory.h"
@@ -23,6 +24,7 @@
 #include "fbpcf/mpc_std_lib/oram/ISinglePointArrayGenerator.h"
 #include "fbpcf/mpc_std_lib/oram/ISinglePointArrayGeneratorFactory.h"
 #include "fbpcf/mpc_std_lib/oram/ObliviousDeltaCalculatorFactory.h"
+#include "fbpcf/mpc_std_lib/oram/PreprocessedSinglePointArrayGeneratorFactory.h"
 #include "fbpcf/mpc_std_lib/oram/SinglePointArrayGeneratorFactory.h"
 #include "fbpcf/mpc_std_lib/oram/test/util.h"
 #include "fbpcf/mpc_std_lib/util/util.h"
@@ -132,4 +134,89 @@ TEST(
   testSinglePointArrayGenerator(std::move(factory0), std::move(factory1));
 }
 
+TEST(
+    SinglePointArrayGeneratorTest,
+    testPreprocessedSinglePointArrayGeneratorWithDummyObliviousDeltaCalculator) {
+  auto factories = engine::communication::getInMemoryAgentFactory(2);
+  auto factory0 =
+      std::make_unique<PreprocessedSinglePointArrayGeneratorFactory>(
+          1,
+          *factories[0],
+          std::make_unique<SinglePointArrayGeneratorFactory>(
+              true,
+              std::make_unique<insecure::DummyObliviousDeltaCalculatorFactory>(
+                  1, *factories[0])));
+  auto factory1 =
+      std::make_unique<PreprocessedSinglePointArrayGeneratorFactory>(
+          0,
+          *factories[1],
+          std::make_unique<SinglePointArrayGeneratorFactory>(
+              false,
+              std::make_unique<insecure::DummyObliviousDeltaCalculatorFactory>(
+                  0, *factories[1])));
+  testSinglePointArrayGenerator(std::move(factory0), std::move(factory1));
+}
+
+TEST(
+    SinglePointArrayGeneratorTest,
+    testPreprocessedSinglePointArrayGeneratorWithObliviousDeltaCalculator) {
+  auto factories = engine::communication::getInMemoryAgentFactory(2);
+  setupRealBackend<0, 1>(*factories[0], *factories[1]);
+
+  auto factory0 =
+      std::make_unique<PreprocessedSinglePointArrayGeneratorFactory>(
+          1,
+          *factories[0],
+          std::make_unique<SinglePointArrayGeneratorFactory>(
+              true,
+              std::make_unique<ObliviousDeltaCalculatorFactory<0>>(
+                  true, 0, 1)));
+  auto factory1 =
+      std::make_unique<PreprocessedSinglePointArrayGeneratorFactory>(
+          0,
+          *factories[1],
+          std::make_unique<SinglePointArrayGeneratorFactory>(
+              false,
+              std::make_unique<ObliviousDeltaCalculatorFactory<1>>(
+                  false, 0, 1)));
+  testSinglePointArrayGenerator(std::move(factory0), std::move(factory1));
+}
+
+TEST(
+    SinglePointArrayGeneratorTest,
+    testPreprocessedSinglePointArrayGeneratorWithMemoryBudget) {
+  auto factories = engine::communication::getInMemoryAgentFactory(2);
+  // only a few full-domain arrays fit, so the batch is processed in tiles.
+  size_t memoryBudget = size_t(1) << 22;
+  auto factory0 =
+      std::make_unique<PreprocessedSinglePointArrayGeneratorFactory>(
+          1,
+          *factories[0],
+          std::make_unique<insecure::DummySinglePointArrayGeneratorFactory>(
+              true, 1, *factories[0]),
+          memoryBudget);
+  auto factory1 =
+      std::make_unique<PreprocessedSinglePointArrayGeneratorFactory>(
+          0,
+          *factories[1],
+          std::make_unique<insecure::DummySinglePointArrayGeneratorFactory>(
+              false, 0, *factories[1]),
+          memoryBudget);
+  testSinglePointArrayGenerator(std::move(factory0), std::move(factory1));
+
+  // a single array of this width is larger than the budget.
+  PreprocessedSinglePointArrayGenerator generator(
+      std::make_unique<insecure::DummySinglePointArrayGenerator>(
+          true, factories[0]->create(1)),
+      factories[0]->create(1),
+      memoryBudget);
+  EXPECT_THROW(generator.preprocess(20, 1), std::invalid_argument);
+  EXPECT_THROW(
+      generator.generateSinglePointArrays(
+          std::vector<std::vector<bool>>(20, std::vector<bool>(1)), 1),
+      std::invalid_argument);
+  // more arrays than fit are rejected too.
+  EXPECT_THROW(generator.preprocess(10, 1000), std::invalid_argument);
+}
+
 } // namespace fbpcf::mpc_std_lib::oram
@@ -0,0 +1,243 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+#include <future>
+#include <memory>
+#include <random>
+#include <stdexcept>
+
+#include "fbpcf/engine/communication/test/AgentFactoryCreationHelper.h"
+#include "fbpcf/frontend/SecretArray.h"
+#include "fbpcf/mpc_std_lib/oram/OramBasedObliviousArray.h"
+#include "fbpcf/mpc_std_lib/oram/SquareRootOramFactory.h"
+#include "fbpcf/mpc_std_lib/shuffler/NonShufflerFactory.h"
+#include "fbpcf/scheduler/PlaintextScheduler.h"
+#include "fbpcf/scheduler/WireKeeper.h"
+#include "fbpcf/test/TestHelper.h"
+
+namespace fbpcf::mpc_std_lib::oram {
+
+std::vector<std::vector<bool>> toPlanes(
+    const std::vector<uint64_t>& values,
+    size_t width) {
+  std::vector<std::vector<bool>> rst(width, std::vector<bool>(values.size()));
+  for (size_t i = 0; i < values.size(); i++) {
+    for (size_t j = 0; j < width; j++) {
+      rst[j][i] = (values.at(i) >> j) & 1;
+    }
+  }
+  return rst;
+}
+
+std::vector<uint64_t> fromPlanes(const std::vector<std::vector<bool>>& planes) {
+  std::vector<uint64_t> rst(planes.at(0).size(), 0);
+  for (size_t i = 0; i < rst.size(); i++) {
+    for (size_t j = 0; j < planes.size(); j++) {
+      rst[i] |= uint64_t(planes.at(j).at(i)) << j;
+    }
+  }
+  return rst;
+}
+
+TEST(SquareRootOramTest, testReadAndWriteWithPlaintextScheduler) {
+  scheduler::SchedulerKeeper<0>::setScheduler(
+      std::make_unique<scheduler::PlaintextScheduler>(
+          scheduler::WireKeeper::createWithUnorderedMap()));
+  // large enough to use a recursive position map.
+  size_t size = 2000;
+  size_t indexWidth = 11;
+  size_t valueWidth = 20;
+  std::random_device rd;
+  std::mt19937_64 e(rd());
+  std::uniform_int_distribution<uint64_t> randomValue(0, (1 << valueWidth) - 1);
+  std::uniform_int_distribution<uint64_t> randomIndex(0, size - 1);
+
+  std::vector<uint64_t> expected(size);
+  for (auto& v : expected) {
+    v = randomValue(e);
+  }
+  SquareRootOramFactory<0> factory(
+      0,
+      1,
+      std::make_unique<shuffler::insecure::NonShufflerFactory<
+          frontend::BitString<true, 0, true>>>());
+  auto oram = factory.create(toPlanes(expected, valueWidth));
+  EXPECT_EQ(oram->getSize(), size);
+
+  for (size_t round = 0; round < 3; round++) {
+    std::vector<uint64_t> writeIndexes(100);
+    std::vector<uint64_t> writeValues(100);
+    for (size_t i = 0; i < writeIndexes.size(); i++) {
+      writeIndexes[i] = randomIndex(e);
+      writeValues[i] = randomValue(e);
+      expected[writeIndexes.at(i)] = writeValues.at(i);
+    }
+    oram->secretWriteBatch(
+        toPlanes(writeIndexes, indexWidth), toPlanes(writeValues, valueWidth));
+
+    std::vector<uint64_t> readIndexes(200);
+    for (size_t i = 0; i < readIndexes.size(); i++) {
+      // read back some of the recent writes too.
+      readIndexes[i] = i % 2 == 0 ? writeIndexes.at(i / 2) : randomIndex(e);
+    }
+    auto rst =
+        fromPlanes(oram->secretReadBatch(toPlanes(readIndexes, indexWidth)));
+    for (size_t i = 0; i < readIndexes.size(); i++) {
+      EXPECT_EQ(rst.at(i), expected.at(readIndexes.at(i)));
+    }
+  }
+
+  EXPECT_THROW(
+      factory.create(std::vector<std::vector<bool>>()), std::invalid_argument);
+}
+
+TEST(SquareRootOramTest, testWideIndex) {
+  scheduler::SchedulerKeeper<0>::setScheduler(
+      std::make_unique<scheduler::PlaintextScheduler>(
+          scheduler::WireKeeper::createWithUnorderedMap()));
+  size_t indexWidth = 64;
+  size_t valueWidth = 8;
+  std::vector<uint64_t> expected({1, 2, 3, 4, 5, 6, 7, 8, 9, 10});
+  SquareRootOramFactory<0> factory(
+      0,
+      1,
+      std::make_unique<shuffler::insecure::NonShufflerFactory<
+          frontend::BitString<true, 0, true>>>());
+  auto oram = factory.create(toPlanes(expected, valueWidth));
+
+  // the out of range indexes agree with valid ones on their low bits and must
+  // be ignored.
+  std::vector<uint64_t> writeIndexes(
+      {3, (uint64_t(1) << 40) + 5, (uint64_t(1) << 63) + 7, 12, 1});
+  std::vector<uint64_t> writeValues({30, 50, 70, 120, 10});
+  expected[3] = 30;
+  expected[1] = 10;
+  oram->secretWriteBatch(
+      toPlanes(writeIndexes, indexWidth), toPlanes(writeValues, valueWidth));
+
+  std::vector<uint64_t> readIndexes(expected.size());
+  for (size_t i = 0; i < readIndexes.size(); i++) {
+    readIndexes[i] = i;
+  }
+  testVectorEq(
+      fromPlanes(oram->secretReadBatch(toPlanes(readIndexes, indexWidth))),
+      expected);
+}
+
+const int8_t kIndexWidth = 7;
+const size_t kSize = 100;
+
+// write to some positions, including out of range ones, then read every value
+// and open the results to party 0.
+template <int schedulerId>
+std::vector<int64_t> secretArrayTask(
+    std::unique_ptr<IReadWriteOramFactory> factory,
+    const std::vector<int64_t>& initialValues,
+    const std::vector<std::pair<uint64_t, int64_t>>& writes) {
+  using SecInt = frontend::Int<true, 24, true, schedulerId, false>;
+  using SecIndex = frontend::Int<false, kIndexWidth, true, schedulerId, false>;
+
+  std::vector<SecInt> values;
+  for (auto v : initialValues) {
+    values.emplace_back(v, 0);
+  }
+  frontend::SecretArray<SecInt, kIndexWidth, schedulerId> array(
+      std::make_unique<
+          OramBasedObliviousArray<SecInt, kIndexWidth, schedulerId>>(
+          values, *factory));
+  EXPECT_EQ(array.size(), initialValues.size());
+
+  for (auto& [index, value] : writes) {
+    array.write(SecIndex(index, 1), SecInt(value, 0));
+  }
+  std::vector<int64_t> rst;
+  for (size_t i = 0; i < initialValues.size(); i++) {
+    rst.push_back(array.read(SecIndex(i, 1)).openToParty(0).getValue());
+  }
+  return rst;
+}
+
+TEST(SquareRootOramTest, testSecretArray) {
+  auto agentFactories = engine::communication::getInMemoryAgentFactory(2);
+  setupRealBackend<0, 1>(*agentFactories[0], *agentFactories[1]);
+
+  std::random_device rd;
+  std::mt19937_64 e(rd());
+  std::uniform_int_distribution<int64_t> randomValue(-(1 << 20), 1 << 20);
+  std::uniform_int_distribution<uint64_t> randomIndex(0, kSize - 1);
+  std::uniform_int_distribution<uint64_t> randomInvalidIndex(
+      kSize, (1 << kIndexWidth) - 1);
+
+  std::vector<int64_t> initialValues(kSize);
+  for (auto& v : initialValues) {
+    v = randomValue(e);
+  }
+  std::vector<std::pair<uint64_t, int64_t>> writes;
+  for (size_t i = 0; i < 20; i++) {
+    writes.emplace_back(randomIndex(e), randomValue(e));
+    writes.emplace_back(randomInvalidIndex(e), randomValue(e));
+  }
+  // write twice to the same position
+  writes.emplace_back(writes.at(0).first, randomValue(e));
+  auto expected = initialValues;
+  for (auto& [index, value] : writes) {
+    if (index < kSize) {
+      expected[index] = value;
+    }
+  }
+
+  auto future0 = std::async(
+      secretArrayTask<0>,
+      getSecureSquareRootOramFactory<0>(0, 1),
+      initialValues,
+      writes);
+  auto future1 = std::async(
+      secretArrayTask<1>,
+      getSecureSquareRootOramFactory<1>(1, 0),
+      initialValues,
+      writes);
+  auto rst = future0.get();
+  future1.get();
+  testVectorEq(rst, expected);
+}
+
+TEST(SquareRootOramTest, testBits) {
+  scheduler::SchedulerKeeper<0>::setScheduler(
+      std::make_unique<scheduler::PlaintextScheduler>(
+          scheduler::WireKeeper::createWithUnorderedMap()));
+  using SecBit = frontend::Bit<true, 0, false>;
+  using SecIndex = frontend::Int<false, 2, true, 0, false>;
+  SquareRootOramFactory<0> factory(
+      0,
+      1,
+      std::make_unique<shuffler::insecure::NonShufflerFactory<
+          frontend::BitString<true, 0, true>>>());
+
+  std::vector<bool> expected({true, false, false});
+  std::vector<SecBit> values;
+  for (auto v : expected) {
+    values.emplace_back(v, 0);
+  }
+  OramBasedObliviousArray<SecBit, 2, 0> array(values, factory);
+  array.write(SecIndex(1u, 0), SecBit(true, 0));
+  array.write(SecIndex(0u, 0), SecBit(false, 0));
+  // out of range, ignored
+  array.write(SecIndex(3u, 0), SecBit(true, 0));
+  expected[1] = true;
+  expected[0] = false;
+  for (size_t i = 0; i < expected.size(); i++) {
+    EXPECT_EQ(
+        array.read(SecIndex(i, 0)).openToParty(0).getValue(), expected[i]);
+  }
+
+  EXPECT_THROW(
+      (OramBasedObliviousArray<SecBit, 2, 0>(std::vector<SecBit>(5), factory)),
+      std::invalid_argument);
+}
+
+} // namespace fbpcf::mpc_std_lib::oram
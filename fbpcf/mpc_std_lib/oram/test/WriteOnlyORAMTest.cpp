@@ -19,6 +19,7 @@
 
 #include "fbpcf/engine/communication/test/AgentFactoryCreationHelper.h"
 #include "fbpcf/engine/util/AesPrgFactory.h"
+#include "fbpcf/mpc_std_lib/oram/AdaptiveWriteOnlyOramFactory.h"
 #include "fbpcf/mpc_std_lib/oram/DifferenceCalculatorFactory.h"
 #include "fbpcf/mpc_std_lib/oram/DummyDifferenceCalculator.h"
 #include "fbpcf/mpc_std_lib/oram/DummyDifferenceCalculatorFactory.h"
@@ -27,6 +28,7 @@
 #include "fbpcf/mpc_std_lib/oram/DummySinglePointArrayGeneratorFactory.h"
 #include "fbpcf/mpc_std_lib/oram/LinearOramFactory.h"
 #include "fbpcf/mpc_std_lib/oram/ObliviousDeltaCalculatorFactory.h"
+#include "fbpcf/mpc_std_lib/oram/ShardedWriteOnlyOramFactory.h"
 #include "fbpcf/mpc_std_lib/oram/SinglePointArrayGeneratorFactory.h"
 #include "fbpcf/mpc_std_lib/oram/WriteOnlyOram.h"
 #include "fbpcf/mpc_std_lib/oram/WriteOnlyOramFactory.h"
@@ -88,7 +90,9 @@ void testWriteOnlyOram(
 }
 
 template <typename T>
-void runOramTestWithDummyComponents() {
+void runOramTestWithDummyComponents(
+    size_t memoryBudget = WriteOnlyOram<T>::kDefaultMemoryBudget,
+    size_t threadCount = 1) {
   const int8_t indicatorSumWidth = 12;
 
   auto factories = engine::communication::getInMemoryAgentFactory(2);
@@ -101,7 +105,9 @@ void runOramTestWithDummyComponents() {
           true, 1, *factories[0]),
       std::make_unique<
           insecure::DummyDifferenceCalculatorFactory<T, indicatorSumWidth>>(
-          true, 1, *factories[0]));
+          true, 1, *factories[0]),
+      memoryBudget,
+      threadCount);
 
   auto factory1 = std::make_unique<WriteOnlyOramFactory<T>>(
       IWriteOnlyOram<T>::Bob,
@@ -111,7 +117,9 @@ void runOramTestWithDummyComponents() {
           false, 0, *factories[1]),
       std::make_unique<
           insecure::DummyDifferenceCalculatorFactory<T, indicatorSumWidth>>(
-          false, 0, *factories[1]));
+          false, 0, *factories[1]),
+      memoryBudget,
+      threadCount);
 
   size_t oramSize = 10; // use a smaller number due to performance issue.
   testWriteOnlyOram<T>(std::move(factory0), std::move(factory1), oramSize);
@@ -120,6 +128,23 @@ void runOramTestWithDummyComponents() {
 TEST(WriteOnlyORAMTest, TestWriteOnlyORAMWithDummyComponents) {
   runOramTestWithDummyComponents<util::TestIntp>();
   runOramTestWithDummyComponents<util::AggregationValue>();
+  runOramTestWithDummyComponents<util::TestMetricsTuple>();
+}
+
+TEST(WriteOnlyORAMTest, TestWriteOnlyORAMWithSmallMemoryBudget) {
+  // only a few writes fit in the budget, so the batch is split into tiles.
+  size_t memoryBudget = 2000;
+  runOramTestWithDummyComponents<util::TestIntp>(memoryBudget);
+  runOramTestWithDummyComponents<util::AggregationValue>(memoryBudget);
+}
+
+TEST(WriteOnlyORAMTest, TestMultiThreadedWriteOnlyORAMWithDummyComponents) {
+  size_t threadCount = 4;
+  runOramTestWithDummyComponents<util::TestIntp>(
+      WriteOnlyOram<util::TestIntp>::kDefaultMemoryBudget, threadCount);
+  runOramTestWithDummyComponents<util::AggregationValue>(
+      WriteOnlyOram<util::AggregationValue>::kDefaultMemoryBudget,
+      threadCount);
 }
 
 template <typename T>
@@ -205,14 +230,25 @@ TEST(WriteOnlyORAMTest, TestWriteOnlyORAMWithDummyOblivousDeltaCalculator) {
 template <typename T>
 void runOramTestWithSecureComponents(
     engine::communication::IPartyCommunicationAgentFactory& agentFactory0,
-    engine::communication::IPartyCommunicationAgentFactory& agentFactory1) {
+    engine::communication::IPartyCommunicationAgentFactory& agentFactory1,
+    size_t threadCount = 1) {
   const int8_t indicatorSumWidth = 12;
 
   auto factory0 = getSecureWriteOnlyOramFactory<T, indicatorSumWidth, 0>(
-      true, 0, 1, agentFactory0);
+      true,
+      0,
+      1,
+      agentFactory0,
+      WriteOnlyOram<T>::kDefaultMemoryBudget,
+      threadCount);
 
   auto factory1 = getSecureWriteOnlyOramFactory<T, indicatorSumWidth, 1>(
-      false, 0, 1, agentFactory1);
+      false,
+      0,
+      1,
+      agentFactory1,
+      WriteOnlyOram<T>::kDefaultMemoryBudget,
+      threadCount);
 
   size_t oramSize = 30;
   testWriteOnlyOram<T>(std::move(factory0), std::move(factory1), oramSize);
@@ -225,6 +261,19 @@ TEST(WriteOnlyORAMTest, TestWriteOnlyORAMWithSecureComponents) {
   runOramTestWithSecureComponents<util::TestIntp>(*factories[0], *factories[1]);
   runOramTestWithSecureComponents<util::AggregationValue>(
       *factories[0], *factories[1]);
+  runOramTestWithSecureComponents<util::TestMetricsTuple>(
+      *factories[0], *factories[1]);
+}
+
+TEST(WriteOnlyORAMTest, TestMultiThreadedWriteOnlyORAMWithSecureComponents) {
+  auto factories = engine::communication::getInMemoryAgentFactory(2);
+  setupRealBackend<0, 1>(*factories[0], *factories[1]);
+
+  size_t threadCount = 4;
+  runOramTestWithSecureComponents<util::TestIntp>(
+      *factories[0], *factories[1], threadCount);
+  runOramTestWithSecureComponents<util::AggregationValue>(
+      *factories[0], *factories[1], threadCount);
 }
 
 template <typename T>
@@ -248,6 +297,174 @@ TEST(LinearORAMTest, TestLinearOram) {
 
   runLinearOramTestWithSecureComponents<util::AggregationValue>(
       *factories[0], *factories[1]);
+
+  runLinearOramTestWithSecureComponents<util::TestMetricsTuple>(
+      *factories[0], *factories[1]);
+}
+
+template <typename T>
+void runAdaptiveOramTestWithSecureComponents(
+    engine::communication::IPartyCommunicationAgentFactory& agentFactory0,
+    engine::communication::IPartyCommunicationAgentFactory& agentFactory1,
+    size_t oramSize,
+    bool expectLinearOram) {
+  const int8_t indicatorSumWidth = 12;
+  // the batch size used by testWriteOnlyOram.
+  size_t batchSize = oramSize * 30;
+
+  auto factory0 =
+      getSecureAdaptiveWriteOnlyOramFactory<T, indicatorSumWidth, 0>(
+          true, 0, 1, agentFactory0, batchSize);
+  auto factory1 =
+      getSecureAdaptiveWriteOnlyOramFactory<T, indicatorSumWidth, 1>(
+          false, 0, 1, agentFactory1, batchSize);
+  EXPECT_EQ(
+      dynamic_cast<AdaptiveWriteOnlyOramFactory<T>&>(*factory0)
+          .choose(oramSize)
+          .useLinearOram,
+      expectLinearOram);
+
+  testWriteOnlyOram<T>(std::move(factory0), std::move(factory1), oramSize);
+}
+
+TEST(AdaptiveWriteOnlyORAMTest, TestAdaptiveOram) {
+  auto factories = engine::communication::getInMemoryAgentFactory(2);
+  setupRealBackend<0, 1>(*factories[0], *factories[1]);
+
+  runAdaptiveOramTestWithSecureComponents<util::TestIntp>(
+      *factories[0], *factories[1], 4, true);
+  runAdaptiveOramTestWithSecureComponents<util::AggregationValue>(
+      *factories[0], *factories[1], 64, false);
+}
+
+TEST(AdaptiveWriteOnlyORAMTest, TestCostModel) {
+  OramCostModel model;
+  size_t valueWidth = 32;
+  size_t indicatorSumWidth = 12;
+  size_t maxThreadCount = 4;
+
+  // tiny orams are cheaper with a linear scan.
+  auto choice =
+      model.choose(4, 16, valueWidth, indicatorSumWidth, maxThreadCount);
+  EXPECT_TRUE(choice.useLinearOram);
+  EXPECT_EQ(choice.threadCount, 1);
+
+  // large orams need the tree-based oram, with all the threads.
+  choice = model.choose(
+      1 << 20, 1024, valueWidth, indicatorSumWidth, maxThreadCount);
+  EXPECT_FALSE(choice.useLinearOram);
+  EXPECT_EQ(choice.threadCount, maxThreadCount);
+
+  // more latency favors the linear oram, which needs fewer rounds.
+  size_t oramSize = 16;
+  size_t batchSize = 64;
+  model.roundTripLatency = 0;
+  EXPECT_FALSE(model
+                   .choose(
+                       oramSize,
+                       batchSize,
+                       valueWidth,
+                       indicatorSumWidth,
+                       maxThreadCount)
+                   .useLinearOram);
+  model.roundTripLatency = 0.05;
+  EXPECT_TRUE(model
+                  .choose(
+                      oramSize,
+                      batchSize,
+                      valueWidth,
+                      indicatorSumWidth,
+                      maxThreadCount)
+                  .useLinearOram);
+}
+
+// run one shard of one party and publicly read the shard's positions.
+template <typename T, int schedulerId>
+std::vector<T> shardedWriteOnlyOramHelper(
+    bool amIParty0,
+    size_t shardIndex,
+    size_t shardCount,
+    std::reference_wrapper<
+        engine::communication::IPartyCommunicationAgentFactory> agentFactory,
+    size_t oramSize,
+    const util::WritingType& input) {
+  const int8_t indicatorSumWidth = 12;
+  ShardedWriteOnlyOramFactory<T, schedulerId> factory(
+      amIParty0 ? IWriteOnlyOram<T>::Alice : IWriteOnlyOram<T>::Bob,
+      shardIndex,
+      shardCount,
+      getSecureWriteOnlyOramFactory<T, indicatorSumWidth, schedulerId>(
+          amIParty0, 0, 1, agentFactory));
+  auto oram = factory.create(oramSize);
+  oram->obliviousAddBatch(input.indexShares, input.valueShares);
+
+  auto shardWidth = factory.getShardWidth(oramSize);
+  auto end = std::min(oramSize, (shardIndex + 1) << shardWidth);
+  std::vector<T> rst;
+  for (size_t i = shardIndex << shardWidth; i < end; i++) {
+    rst.push_back(oram->publicRead(i, IWriteOnlyOram<T>::Alice));
+  }
+  EXPECT_THROW(
+      oram->publicRead(end % oramSize, IWriteOnlyOram<T>::Alice),
+      std::runtime_error);
+  return rst;
+}
+
+TEST(WriteOnlyORAMTest, TestShardedWriteOnlyORAMWithSecureComponents) {
+  using T = util::TestIntp;
+  // each shard of each party has its own scheduler and agents.
+  auto shard0Factories = engine::communication::getInMemoryAgentFactory(2);
+  auto shard1Factories = engine::communication::getInMemoryAgentFactory(2);
+  setupRealBackend<0, 1>(*shard0Factories[0], *shard0Factories[1]);
+  setupRealBackend<2, 3>(*shard1Factories[0], *shard1Factories[1]);
+
+  size_t oramSize = 30;
+  size_t shardCount = 2;
+  auto [input0, input1, expectedValue] =
+      util::generateRandomValuesToAdd<T>(oramSize, oramSize * 10);
+
+  auto future00 = std::async(
+      shardedWriteOnlyOramHelper<T, 0>,
+      true,
+      0,
+      shardCount,
+      std::ref(*shard0Factories[0]),
+      oramSize,
+      std::cref(input0));
+  auto future10 = std::async(
+      shardedWriteOnlyOramHelper<T, 1>,
+      false,
+      0,
+      shardCount,
+      std::ref(*shard0Factories[1]),
+      oramSize,
+      std::cref(input1));
+  auto future01 = std::async(
+      shardedWriteOnlyOramHelper<T, 2>,
+      true,
+      1,
+      shardCount,
+      std::ref(*shard1Factories[0]),
+      oramSize,
+      std::cref(input0));
+  auto future11 = std::async(
+      shardedWriteOnlyOramHelper<T, 3>,
+      false,
+      1,
+      shardCount,
+      std::ref(*shard1Factories[1]),
+      oramSize,
+      std::cref(input1));
+
+  auto result = future00.get();
+  auto shard1Result = future01.get();
+  future10.get();
+  future11.get();
+  result.insert(result.end(), shard1Result.begin(), shard1Result.end());
+  ASSERT_EQ(result.size(), oramSize);
+  for (size_t i = 0; i < oramSize; i++) {
+    EXPECT_EQ(result.at(i), expectedValue.at(i));
+  }
 }
 
 } // namespace fbpcf::mpc_std_lib::oram
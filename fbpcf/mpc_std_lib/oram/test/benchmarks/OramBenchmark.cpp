@@ -6,18 +6,23 @@
  */
 
 #include <folly/Benchmark.h>
+#include <random>
 
 #include "common/init/Init.h"
 
 #include "fbpcf/engine/util/test/benchmarks/BenchmarkHelper.h"
 #include "fbpcf/engine/util/test/benchmarks/NetworkedBenchmark.h"
+#include "fbpcf/frontend/SecretArray.h"
 #include "fbpcf/mpc_std_lib/oram/DifferenceCalculatorFactory.h"
 #include "fbpcf/mpc_std_lib/oram/IDifferenceCalculatorFactory.h"
 #include "fbpcf/mpc_std_lib/oram/ISinglePointArrayGenerator.h"
 #include "fbpcf/mpc_std_lib/oram/IWriteOnlyOram.h"
 #include "fbpcf/mpc_std_lib/oram/LinearOramFactory.h"
 #include "fbpcf/mpc_std_lib/oram/ObliviousDeltaCalculatorFactory.h"
+#include "fbpcf/mpc_std_lib/oram/OramBasedObliviousArray.h"
+#include "fbpcf/mpc_std_lib/oram/OramCostModel.h"
 #include "fbpcf/mpc_std_lib/oram/SinglePointArrayGeneratorFactory.h"
+#include "fbpcf/mpc_std_lib/oram/SquareRootOramFactory.h"
 #include "fbpcf/mpc_std_lib/oram/WriteOnlyOramFactory.h"
 #include "fbpcf/mpc_std_lib/util/test/util.h"
 #include "fbpcf/scheduler/IScheduler.h"
@@ -245,9 +250,8 @@ class BaseWriteOnlyOramBenchmark : public engine::util::NetworkedBenchmark {
     agentFactory0_ = std::move(agentFactory0);
     agentFactory1_ = std::move(agentFactory1);
 
-    auto batchSize = 2048;
     auto [input0, input1, _] =
-        util::generateRandomValuesToAdd<uint32_t>(oramSize_, batchSize);
+        util::generateRandomValuesToAdd<uint32_t>(oramSize_, batchSize_);
     input0_ = input0;
     input1_ = input1;
   }
@@ -297,6 +301,7 @@ class BaseWriteOnlyOramBenchmark : public engine::util::NetworkedBenchmark {
       agentFactory1_;
 
   size_t oramSize_ = 150;
+  size_t batchSize_ = 2048;
 
  private:
   std::unique_ptr<IWriteOnlyOram<uint32_t>> sender_;
@@ -374,6 +379,56 @@ BENCHMARK_COUNTERS(WriteOnlyOramSecretRead_Benchmark, counters) {
   benchmark.runBenchmark(counters);
 }
 
+// measures how obliviousAddBatch scales with the number of threads on a
+// larger oram.
+template <size_t threadCount>
+class MultiThreadedWriteOnlyOramObliviousAddBatchBenchmark
+    : public ObliviousAddBatchBenchmark {
+ public:
+  MultiThreadedWriteOnlyOramObliviousAddBatchBenchmark() {
+    oramSize_ = 4096;
+  }
+
+ protected:
+  std::unique_ptr<IWriteOnlyOramFactory<uint32_t>> getOramFactory(
+      bool amIParty0) override {
+    return amIParty0
+        ? getSecureWriteOnlyOramFactory<uint32_t, indicatorWidth, 0>(
+              true,
+              0,
+              1,
+              *agentFactory0_,
+              WriteOnlyOram<uint32_t>::kDefaultMemoryBudget,
+              threadCount)
+        : getSecureWriteOnlyOramFactory<uint32_t, indicatorWidth, 1>(
+              false,
+              0,
+              1,
+              *agentFactory1_,
+              WriteOnlyOram<uint32_t>::kDefaultMemoryBudget,
+              threadCount);
+  }
+};
+
+BENCHMARK_COUNTERS(WriteOnlyOramObliviousAddBatch_1Thread_Benchmark, counters) {
+  MultiThreadedWriteOnlyOramObliviousAddBatchBenchmark<1> benchmark;
+  benchmark.runBenchmark(counters);
+}
+
+BENCHMARK_COUNTERS(
+    WriteOnlyOramObliviousAddBatch_2Threads_Benchmark,
+    counters) {
+  MultiThreadedWriteOnlyOramObliviousAddBatchBenchmark<2> benchmark;
+  benchmark.runBenchmark(counters);
+}
+
+BENCHMARK_COUNTERS(
+    WriteOnlyOramObliviousAddBatch_4Threads_Benchmark,
+    counters) {
+  MultiThreadedWriteOnlyOramObliviousAddBatchBenchmark<4> benchmark;
+  benchmark.runBenchmark(counters);
+}
+
 class LinearOramBenchmark : virtual public BaseWriteOnlyOramBenchmark {
  protected:
   std::unique_ptr<IWriteOnlyOramFactory<uint32_t>> getOramFactory(
@@ -408,6 +463,220 @@ BENCHMARK_COUNTERS(LinearOramSecretRead_Benchmark, counters) {
   LinearOramSecretReadBenchmark benchmark;
   benchmark.runBenchmark(counters);
 }
+
+// a sweep over oram sizes and batch sizes for both write-only oram
+// implementations. The measured times are reported next to the estimates of
+// OramCostModel, such that its unit costs can be refitted.
+template <bool useLinearOram, size_t oramSize, size_t batchSize>
+class OramSweepBenchmark : public ObliviousAddBatchBenchmark {
+ public:
+  OramSweepBenchmark() {
+    oramSize_ = oramSize;
+    batchSize_ = batchSize;
+  }
+
+ protected:
+  std::unique_ptr<IWriteOnlyOramFactory<uint32_t>> getOramFactory(
+      bool amIParty0) override {
+    if (useLinearOram) {
+      return amIParty0
+          ? getSecureLinearOramFactory<uint32_t, 0>(true, 0, 1, *agentFactory0_)
+          : getSecureLinearOramFactory<uint32_t, 1>(
+                false, 0, 1, *agentFactory1_);
+    }
+    return amIParty0
+        ? getSecureWriteOnlyOramFactory<uint32_t, indicatorWidth, 0>(
+              true, 0, 1, *agentFactory0_)
+        : getSecureWriteOnlyOramFactory<uint32_t, indicatorWidth, 1>(
+              false, 0, 1, *agentFactory1_);
+  }
+};
+
+template <bool useLinearOram, size_t oramSize, size_t batchSize>
+void runOramSweepBenchmark(folly::UserCounters& counters) {
+  OramSweepBenchmark<useLinearOram, oramSize, batchSize> benchmark;
+  benchmark.runBenchmark(counters);
+
+  // the benchmark runs on localhost, so there is (almost) no latency.
+  OramCostModel model;
+  model.roundTripLatency = 0;
+  auto valueWidth = util::Adapters<uint32_t>::convertToBits(0).size();
+  auto estimate = useLinearOram
+      ? model.estimateLinearOramCost(oramSize, batchSize, valueWidth)
+      : model.estimateWriteOnlyOramCost(
+            oramSize, batchSize, valueWidth, indicatorWidth, 1);
+  counters["estimated_usec"] = static_cast<int64_t>(estimate * 1e6);
+}
+
+BENCHMARK_COUNTERS(OramSweep_Linear_16_16, counters) {
+  runOramSweepBenchmark<true, 16, 16>(counters);
+}
+
+BENCHMARK_COUNTERS(OramSweep_Linear_16_2048, counters) {
+  runOramSweepBenchmark<true, 16, 2048>(counters);
+}
+
+BENCHMARK_COUNTERS(OramSweep_Linear_256_16, counters) {
+  runOramSweepBenchmark<true, 256, 16>(counters);
+}
+
+BENCHMARK_COUNTERS(OramSweep_Linear_256_2048, counters) {
+  runOramSweepBenchmark<true, 256, 2048>(counters);
+}
+
+BENCHMARK_COUNTERS(OramSweep_Linear_4096_16, counters) {
+  runOramSweepBenchmark<true, 4096, 16>(counters);
+}
+
+BENCHMARK_COUNTERS(OramSweep_WriteOnly_16_16, counters) {
+  runOramSweepBenchmark<false, 16, 16>(counters);
+}
+
+BENCHMARK_COUNTERS(OramSweep_WriteOnly_16_2048, counters) {
+  runOramSweepBenchmark<false, 16, 2048>(counters);
+}
+
+BENCHMARK_COUNTERS(OramSweep_WriteOnly_256_16, counters) {
+  runOramSweepBenchmark<false, 256, 16>(counters);
+}
+
+BENCHMARK_COUNTERS(OramSweep_WriteOnly_256_2048, counters) {
+  runOramSweepBenchmark<false, 256, 2048>(counters);
+}
+
+BENCHMARK_COUNTERS(OramSweep_WriteOnly_4096_16, counters) {
+  runOramSweepBenchmark<false, 4096, 16>(counters);
+}
+
+BENCHMARK_COUNTERS(OramSweep_WriteOnly_4096_2048, counters) {
+  runOramSweepBenchmark<false, 4096, 2048>(counters);
+}
+
+const int8_t secretArrayIndexWidth = 12;
+
+template <int schedulerId>
+using SecretArrayValue = frontend::Int<false, 32, true, schedulerId, false>;
+
+template <int schedulerId>
+using BenchmarkSecretArray = frontend::SecretArray<
+    SecretArrayValue<schedulerId>,
+    secretArrayIndexWidth,
+    schedulerId>;
+
+class BaseSecretArrayBenchmark : public engine::util::NetworkedBenchmark {
+ public:
+  void setup() override {
+    auto [agentFactory0, agentFactory1] =
+        engine::util::getSocketAgentFactories();
+    agentFactory0_ = std::move(agentFactory0);
+    agentFactory1_ = std::move(agentFactory1);
+
+    std::random_device rd;
+    std::mt19937_64 e(rd());
+    std::uniform_int_distribution<uint64_t> randomIndex(0, arraySize_ - 1);
+    indexes_ = std::vector<uint64_t>(accessCount_);
+    for (auto& index : indexes_) {
+      index = randomIndex(e);
+    }
+  }
+
+ protected:
+  void initSender() override {
+    scheduler::SchedulerKeeper<0>::setScheduler(
+        scheduler::createLazySchedulerWithRealEngine(0, *agentFactory0_));
+    sender_ = createArray<0>(0, 1);
+  }
+
+  void runSender() override {
+    readAll<0>(*sender_);
+  }
+
+  void initReceiver() override {
+    scheduler::SchedulerKeeper<1>::setScheduler(
+        scheduler::createLazySchedulerWithRealEngine(1, *agentFactory1_));
+    receiver_ = createArray<1>(1, 0);
+  }
+
+  void runReceiver() override {
+    readAll<1>(*receiver_);
+  }
+
+  std::pair<uint64_t, uint64_t> getTrafficStatistics() override {
+    return scheduler::SchedulerKeeper<0>::getTrafficStatistics();
+  }
+
+  virtual bool useOram() const = 0;
+
+ private:
+  template <int schedulerId>
+  std::unique_ptr<BenchmarkSecretArray<schedulerId>> createArray(
+      int myId,
+      int partnerId) {
+    std::vector<SecretArrayValue<schedulerId>> values;
+    for (size_t i = 0; i < arraySize_; i++) {
+      values.emplace_back(i, 0);
+    }
+    if (!useOram()) {
+      return std::make_unique<BenchmarkSecretArray<schedulerId>>(values);
+    }
+    auto factory = getSecureSquareRootOramFactory<schedulerId>(myId, partnerId);
+    return std::make_unique<BenchmarkSecretArray<schedulerId>>(
+        std::make_unique<OramBasedObliviousArray<
+            SecretArrayValue<schedulerId>,
+            secretArrayIndexWidth,
+            schedulerId>>(values, *factory));
+  }
+
+  // the indexes are party 0's input; opening every result makes sure the lazy
+  // scheduler actually runs the reads.
+  template <int schedulerId>
+  void readAll(BenchmarkSecretArray<schedulerId>& array) {
+    for (auto index : indexes_) {
+      array
+          .read(frontend::Int<false, secretArrayIndexWidth, true, schedulerId>(
+              index, 0))
+          .openToParty(0)
+          .getValue();
+    }
+  }
+
+  size_t arraySize_ = 4096;
+  size_t accessCount_ = 256;
+
+  std::unique_ptr<engine::communication::IPartyCommunicationAgentFactory>
+      agentFactory0_;
+  std::unique_ptr<engine::communication::IPartyCommunicationAgentFactory>
+      agentFactory1_;
+
+  std::unique_ptr<BenchmarkSecretArray<0>> sender_;
+  std::unique_ptr<BenchmarkSecretArray<1>> receiver_;
+
+  std::vector<uint64_t> indexes_;
+};
+
+class LinearScanSecretReadBenchmark : public BaseSecretArrayBenchmark {
+ protected:
+  bool useOram() const override {
+    return false;
+  }
+};
+
+BENCHMARK_COUNTERS(LinearScanSecretRead_Benchmark, counters) {
+  LinearScanSecretReadBenchmark benchmark;
+  benchmark.runBenchmark(counters);
+}
+
+class SquareRootOramSecretReadBenchmark : public BaseSecretArrayBenchmark {
+ protected:
+  bool useOram() const override {
+    return true;
+  }
+};
+
+BENCHMARK_COUNTERS(SquareRootOramSecretRead_Benchmark, counters) {
+  SquareRootOramSecretReadBenchmark benchmark;
+  benchmark.runBenchmark(counters);
+}
 } // namespace fbpcf::mpc_std_lib::oram
 
 int main(int argc, char* argv[]) {
@@ -6,56 +6,220 @@
  */
 
 #include "fbpcf/mpc_std_lib/permuter/AsWaksmanPermuter.h"
+#include <algorithm>
 
 namespace fbpcf::mpc_std_lib::permuter {
 
-void AsWaksmanParameterCalculator::compute() {
-  uint32_t nextIndexInSecondHalf = size_ - 1;
+void AsWaksmanParameterCalculator::compute(
+    const uint32_t* order,
+    size_t size,
+    uint32_t* inversedOrder,
+    uint8_t* firstSwapConditions,
+    uint8_t* secondSwapConditions,
+    uint32_t* firstSubPermuteOrder,
+    uint32_t* secondSubPermuteOrder) {
+  Router router{
+      size,
+      size / 2,
+      size - size / 2,
+      order,
+      inversedOrder,
+      firstSwapConditions,
+      secondSwapConditions,
+      firstSubPermuteOrder,
+      secondSubPermuteOrder};
+  for (size_t i = 0; i < size; i++) {
+    inversedOrder[order[i]] = i;
+  }
+  std::fill(firstSwapConditions, firstSwapConditions + size / 2, 0);
+  std::fill(secondSwapConditions, secondSwapConditions + (size - 1) / 2, 0);
+  std::fill(
+      firstSubPermuteOrder,
+      firstSubPermuteOrder + size / 2,
+      static_cast<uint32_t>(-1));
+  std::fill(
+      secondSubPermuteOrder,
+      secondSubPermuteOrder + size - size / 2,
+      static_cast<uint32_t>(-1));
+  router.compute();
+}
+
+void AsWaksmanParameterCalculator::Router::compute() {
+  uint32_t nextIndexInSecondHalf = size - 1;
   do {
     nextIndexInSecondHalf = fillIntoSecondHalf(nextIndexInSecondHalf);
 
-    if ((nextIndexInSecondHalf >= size_ /* check if it's an invalid value*/) ||
-        (findIndexInSubPermute(nextIndexInSecondHalf) >= secondHalfSize_) ||
-        (secondSubPermuteOrder_.at(
-             findIndexInSubPermute(nextIndexInSecondHalf)) < secondHalfSize_)) {
+    if ((nextIndexInSecondHalf >= size /* check if it's an invalid value*/) ||
+        (findIndexInSubPermute(nextIndexInSecondHalf) >= secondHalfSize) ||
+        (secondSubPermuteOrder[findIndexInSubPermute(nextIndexInSecondHalf)] <
+         secondHalfSize)) {
       nextIndexInSecondHalf = findAFreeIndex();
 
-      if (nextIndexInSecondHalf >= size_ /* check if it's an invalid value*/) {
+      if (nextIndexInSecondHalf >= size /* check if it's an invalid value*/) {
         return;
       }
       auto subIndex = findIndexInSubPermute(nextIndexInSecondHalf);
-      secondSwapConditions_[subIndex] = false;
+      secondSwapConditions[subIndex] = false;
     }
 
   } while (1);
 }
 
-uint32_t AsWaksmanParameterCalculator::fillIntoSecondHalf(
+uint32_t AsWaksmanParameterCalculator::Router::fillIntoSecondHalf(
     uint32_t indexAfterPermute) {
-  auto indexBeforePermute = expectedOrder_.at(indexAfterPermute);
+  auto indexBeforePermute = expectedOrder[indexAfterPermute];
 
   auto subIndexBeforePermute = findIndexInSubPermute(indexBeforePermute);
   auto subIndexAfterPermute = findIndexInSubPermute(indexAfterPermute);
-  secondSubPermuteOrder_[subIndexAfterPermute] = subIndexBeforePermute;
+  secondSubPermuteOrder[subIndexAfterPermute] = subIndexBeforePermute;
 
   auto dualIndexBeforePermute = findDualIndex(indexBeforePermute);
-  if (dualIndexBeforePermute >= size_ /* check if it's an invalid value*/) {
+  if (dualIndexBeforePermute >= size /* check if it's an invalid value*/) {
     return static_cast<uint32_t>(-1);
   }
-  firstSwapConditions_[subIndexBeforePermute] =
-      indexBeforePermute < firstHalfSize_;
-  auto dualIndexAfterPermute = inversedOrder_.at(dualIndexBeforePermute);
+  firstSwapConditions[subIndexBeforePermute] =
+      indexBeforePermute < firstHalfSize;
+  auto dualIndexAfterPermute = inversedOrder[dualIndexBeforePermute];
 
   auto subIndexForDualIndexAfterPermute =
       findIndexInSubPermute(dualIndexAfterPermute);
-  firstSubPermuteOrder_[subIndexForDualIndexAfterPermute] =
+  firstSubPermuteOrder[subIndexForDualIndexAfterPermute] =
       subIndexBeforePermute;
 
-  if (subIndexForDualIndexAfterPermute < secondHalfSize_ - 1) {
-    secondSwapConditions_[subIndexForDualIndexAfterPermute] =
-        dualIndexAfterPermute >= firstHalfSize_;
+  if (subIndexForDualIndexAfterPermute < secondHalfSize - 1) {
+    secondSwapConditions[subIndexForDualIndexAfterPermute] =
+        dualIndexAfterPermute >= firstHalfSize;
   }
   return findDualIndex(dualIndexAfterPermute);
 }
 
+AsWaksmanNetwork::AsWaksmanNetwork(size_t size) {
+  layOut(size);
+}
+
+AsWaksmanNetwork::AsWaksmanNetwork(
+    const std::vector<uint32_t>& order,
+    size_t threadCount) {
+  layOut(order.size());
+  route(order, threadCount);
+}
+
+std::vector<AsWaksmanNetwork::Subnetwork> AsWaksmanNetwork::getSubnetworks(
+    const std::vector<Subnetwork>& subnetworks) {
+  std::vector<Subnetwork> rst;
+  rst.reserve(2 * subnetworks.size());
+  for (auto& item : subnetworks) {
+    uint32_t half = item.size / 2;
+    if (half >= 2) {
+      rst.push_back({item.offset, half});
+    }
+    if (item.size - half >= 2) {
+      rst.push_back({item.offset + half, item.size - half});
+    }
+  }
+  return rst;
+}
+
+void AsWaksmanNetwork::layOut(size_t size) {
+  std::vector<Subnetwork> subnetworks;
+  if (size >= 2) {
+    subnetworks.push_back({0, static_cast<uint32_t>(size)});
+  }
+  // the first swaps of each depth are evaluated top-down and the last swaps
+  // bottom-up.
+  std::vector<std::vector<SwapGroup>> lastSwaps;
+  while (!subnetworks.empty()) {
+    std::vector<SwapGroup> firstLayer;
+    std::vector<SwapGroup> lastLayer;
+    for (auto& item : subnetworks) {
+      uint32_t half = item.size / 2;
+      firstLayer.push_back({item.offset, item.offset + half, half});
+      if ((item.size - 1) / 2 > 0) {
+        lastLayer.push_back(
+            {item.offset, item.offset + half, (item.size - 1) / 2});
+      }
+    }
+    layers_.push_back(std::move(firstLayer));
+    lastSwaps.push_back(std::move(lastLayer));
+    subnetworks = getSubnetworks(subnetworks);
+  }
+
+  lastSwapLayers_ = std::vector<size_t>(lastSwaps.size(), 0);
+  for (size_t i = lastSwaps.size(); i > 0; i--) {
+    if (!lastSwaps.at(i - 1).empty()) {
+      lastSwapLayers_[i - 1] = layers_.size();
+      layers_.push_back(std::move(lastSwaps[i - 1]));
+    }
+  }
+
+  for (auto& layer : layers_) {
+    uint32_t layerSize = 0;
+    for (auto& group : layer) {
+      layerSize += group.count;
+    }
+    layerSizes_.push_back(layerSize);
+    swapCount_ += layerSize;
+  }
+}
+
+void AsWaksmanNetwork::route(
+    const std::vector<uint32_t>& order,
+    size_t threadCount) {
+  auto size = order.size();
+  std::vector<size_t> layerOffsets(layers_.size() + 1, 0);
+  for (size_t i = 0; i < layers_.size(); i++) {
+    layerOffsets[i + 1] = layerOffsets.at(i) + layerSizes_.at(i);
+  }
+
+  // the subnetworks of one depth permute disjoint ranges of these buffers, so
+  // they can be routed in parallel without allocating memory.
+  std::vector<uint8_t> conditions(swapCount_);
+  std::vector<uint32_t> subOrders = order;
+  std::vector<uint32_t> nextSubOrders(size);
+  std::vector<uint32_t> inversedOrders(size);
+
+  std::vector<Subnetwork> subnetworks;
+  if (size >= 2) {
+    subnetworks.push_back({0, static_cast<uint32_t>(size)});
+  }
+  std::vector<size_t> firstConditionIndexes;
+  std::vector<size_t> lastConditionIndexes;
+  for (size_t depth = 0; !subnetworks.empty(); depth++) {
+    // the subnetworks appear in the layers in the same order as here.
+    firstConditionIndexes.resize(subnetworks.size());
+    lastConditionIndexes.resize(subnetworks.size());
+    auto firstIndex = layerOffsets.at(depth);
+    auto lastIndex = layerOffsets.at(lastSwapLayers_.at(depth));
+    for (size_t i = 0; i < subnetworks.size(); i++) {
+      firstConditionIndexes[i] = firstIndex;
+      lastConditionIndexes[i] = lastIndex;
+      firstIndex += subnetworks.at(i).size / 2;
+      lastIndex += (subnetworks.at(i).size - 1) / 2;
+    }
+
+    util::parallelFor(
+        subnetworks.size(), threadCount, [&](size_t begin, size_t end) {
+          for (size_t i = begin; i < end; i++) {
+            auto [offset, subSize] = subnetworks.at(i);
+            if (subSize == 2) {
+              conditions[firstConditionIndexes.at(i)] =
+                  subOrders.at(offset) == 1;
+              continue;
+            }
+            AsWaksmanParameterCalculator::compute(
+                subOrders.data() + offset,
+                subSize,
+                inversedOrders.data() + offset,
+                conditions.data() + firstConditionIndexes.at(i),
+                conditions.data() + lastConditionIndexes.at(i),
+                nextSubOrders.data() + offset,
+                nextSubOrders.data() + offset + subSize / 2);
+          }
+        });
+    std::swap(subOrders, nextSubOrders);
+    subnetworks = getSubnetworks(subnetworks);
+  }
+  swapConditions_ = std::vector<bool>(conditions.begin(), conditions.end());
+}
+
 } // namespace fbpcf::mpc_std_lib::permuter
@@ -7,24 +7,104 @@
 
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
 #include "fbpcf/mpc_std_lib/permuter/IPermuter.h"
 
 #include "fbpcf/mpc_std_lib/util/util.h"
 
 namespace fbpcf::mpc_std_lib::permuter {
 
+/**
+ * The layout of an AS-Waksman network of a given size. A network of size n
+ * swaps the values at i and n / 2 + i for i < n / 2, permutes the two halves
+ * with two subnetworks, and swaps the values at i and n / 2 + i again for
+ * i < (n - 1) / 2. The first swaps of all subnetworks of the same recursion
+ * depth act on disjoint positions, and so do the last swaps, so the network
+ * can be evaluated as a sequence of layers: the first swaps from the top depth
+ * down, then the last swaps from the bottom depth up.
+ */
+class AsWaksmanNetwork {
+ public:
+  // swap the values at leftStart + i and rightStart + i for i < count.
+  struct SwapGroup {
+    uint32_t leftStart;
+    uint32_t rightStart;
+    uint32_t count;
+  };
+
+  // lay out the network only, e.g. for the party that does not know the
+  // order.
+  explicit AsWaksmanNetwork(size_t size);
+
+  // lay out the network and compute the swap conditions to permute to order.
+  // The subnetworks of the same depth are routed by up to threadCount threads
+  // in parallel.
+  explicit AsWaksmanNetwork(
+      const std::vector<uint32_t>& order,
+      size_t threadCount = 1);
+
+  // the swap groups of each layer, in the order they are evaluated.
+  const std::vector<std::vector<SwapGroup>>& getLayers() const {
+    return layers_;
+  }
+
+  // the number of swaps in each layer.
+  const std::vector<uint32_t>& getLayerSizes() const {
+    return layerSizes_;
+  }
+
+  // the swap conditions of all the layers, layer after layer.
+  std::vector<bool> getSwapConditions() {
+    return std::move(swapConditions_);
+  }
+
+  size_t getSwapCount() const {
+    return swapCount_;
+  }
+
+ private:
+  struct Subnetwork {
+    uint32_t offset;
+    uint32_t size;
+  };
+
+  // the subnetworks of the next depth, of size 2 or more.
+  static std::vector<Subnetwork> getSubnetworks(
+      const std::vector<Subnetwork>& subnetworks);
+
+  void layOut(size_t size);
+
+  void route(const std::vector<uint32_t>& order, size_t threadCount);
+
+  std::vector<std::vector<SwapGroup>> layers_;
+  std::vector<uint32_t> layerSizes_;
+  // the index of the layer with the last swaps of each depth, if any.
+  std::vector<size_t> lastSwapLayers_;
+  std::vector<bool> swapConditions_;
+  size_t swapCount_ = 0;
+};
+
 /**
  * This permuter uses the AS-Waksman network to run oblivious permutation. Read
  * more about this network:  Bruno Beauquier, Eric Darrot. On Arbitrary Waksman
  * Networks and their Vulnerability. RR-3788, INRIA. 1999. inria-00072871f
+ * The network is evaluated one layer at a time, with all the swaps of a layer
+ * in one batch, so its depth is the number of layers, about 2 * log2(size).
  **/
 template <typename T, int schedulerId>
 class AsWaksmanPermuter final
     : public IPermuter<typename util::SecBatchType<T, schedulerId>::type> {
  public:
   using SecBatchType = typename util::SecBatchType<T, schedulerId>::type;
-  AsWaksmanPermuter(int myId, int partnerId)
-      : myId_(myId), partnerId_(partnerId) {}
+  /**
+   * @param threadCount the number of threads to compute the swap conditions
+   * with, which is worthwhile for large permutations.
+   */
+  AsWaksmanPermuter(int myId, int partnerId, size_t threadCount = 1)
+      : myId_(myId), partnerId_(partnerId), threadCount_(threadCount) {}
 
   SecBatchType permute(const SecBatchType& src, size_t size) const override;
 
@@ -34,23 +114,25 @@ class AsWaksmanPermuter final
       const std::vector<uint32_t>& order) const override;
 
  private:
-  std::pair<SecBatchType, SecBatchType> preSubPermutationSwap(
+  SecBatchType evaluateNetwork(
       const SecBatchType& src,
-      frontend::Bit<true, schedulerId, true>&& firstSwapConditions,
-      size_t size) const;
-
-  SecBatchType postSubPermutationSwap(
-      SecBatchType&& src0,
-      SecBatchType&& src1,
-      frontend::Bit<true, schedulerId, true>&& secondSwapConditions,
-      size_t size) const;
+      size_t size,
+      const AsWaksmanNetwork& network,
+      frontend::Bit<true, schedulerId, true>&& swapConditions) const;
 
-  SecBatchType processTwoElements(
+  // run the swaps of one layer in a single batch.
+  SecBatchType evaluateLayer(
       const SecBatchType& src,
+      size_t size,
+      const std::vector<AsWaksmanNetwork::SwapGroup>& layer,
       frontend::Bit<true, schedulerId, true>&& swapConditions) const;
 
+  // concatenate batches in order.
+  static SecBatchType concatenate(std::vector<SecBatchType>&& batches);
+
   int myId_;
   int partnerId_;
+  size_t threadCount_;
 };
 
 /**
@@ -63,27 +145,29 @@ class AsWaksmanPermuter final
 class AsWaksmanParameterCalculator {
  public:
   explicit AsWaksmanParameterCalculator(const std::vector<uint32_t>& order)
-      : size_(order.size()),
-        firstHalfSize_(size_ / 2),
-        secondHalfSize_(size_ - firstHalfSize_),
-        expectedOrder_(order),
-        inversedOrder_(size_),
-        firstSwapConditions_(firstHalfSize_),
-        secondSwapConditions_(secondHalfSize_ - 1),
-        firstSubPermuteOrder_(firstHalfSize_, static_cast<uint32_t>(-1)),
-        secondSubPermuteOrder_(secondHalfSize_, static_cast<uint32_t>(-1)) {
-    for (size_t i = 0; i < size_; i++) {
-      inversedOrder_[expectedOrder_.at(i)] = i;
-    }
-    compute();
+      : inversedOrder_(order.size()),
+        firstSwapConditions_(order.size() / 2),
+        secondSwapConditions_((order.size() - 1) / 2),
+        firstSubPermuteOrder_(order.size() / 2),
+        secondSubPermuteOrder_(order.size() - order.size() / 2) {
+    compute(
+        order.data(),
+        order.size(),
+        inversedOrder_.data(),
+        firstSwapConditions_.data(),
+        secondSwapConditions_.data(),
+        firstSubPermuteOrder_.data(),
+        secondSubPermuteOrder_.data());
   }
 
   std::vector<bool> getFirstSwapConditions() {
-    return std::move(firstSwapConditions_);
+    return std::vector<bool>(
+        firstSwapConditions_.begin(), firstSwapConditions_.end());
   }
 
   std::vector<bool> getSecondSwapConditions() {
-    return std::move(secondSwapConditions_);
+    return std::vector<bool>(
+        secondSwapConditions_.begin(), secondSwapConditions_.end());
   }
 
   std::vector<uint32_t> getFirstSubPermuteOrder() {
@@ -94,52 +178,75 @@ class AsWaksmanParameterCalculator {
     return std::move(secondSubPermuteOrder_);
   }
 
+  /**
+   * Calculate the parameters to permute order[0, size) into buffers provided
+   * by the caller, without allocating any memory. The buffers need room for
+   * size, size / 2, (size - 1) / 2, size / 2 and size - size / 2 entries
+   * respectively; inversedOrder is used as scratch space.
+   */
+  static void compute(
+      const uint32_t* order,
+      size_t size,
+      uint32_t* inversedOrder,
+      uint8_t* firstSwapConditions,
+      uint8_t* secondSwapConditions,
+      uint32_t* firstSubPermuteOrder,
+      uint32_t* secondSubPermuteOrder);
+
  private:
-  void compute();
-  uint32_t fillIntoSecondHalf(uint32_t indexAfterPermute);
-
-  // find the index of the dual element
-  inline uint32_t findDualIndex(uint32_t index) const {
-    // the last element has no dual element when size is odd
-    if ((index == size_ - 1) && ((size_ % 2) == 1)) {
-      return static_cast<uint32_t>(-1);
-    }
-    if (index >= firstHalfSize_) {
-      return index - firstHalfSize_;
-    } else {
-      return index + firstHalfSize_;
-    }
-  }
+  // the routing state of one network, in the caller's buffers.
+  struct Router {
+    size_t size;
+    size_t firstHalfSize;
+    size_t secondHalfSize;
+    const uint32_t* expectedOrder;
+    uint32_t* inversedOrder;
+    uint8_t* firstSwapConditions;
+    uint8_t* secondSwapConditions;
+    uint32_t* firstSubPermuteOrder;
+    uint32_t* secondSubPermuteOrder;
 
-  // find the corresponding index in the sub permute
-  inline uint32_t findIndexInSubPermute(uint32_t index) const {
-    if (index >= firstHalfSize_) {
-      return index - firstHalfSize_;
-    } else {
-      return index;
-    }
-  }
+    void compute();
+    uint32_t fillIntoSecondHalf(uint32_t indexAfterPermute);
 
-  inline uint32_t findAFreeIndex() const {
-    size_t index = secondHalfSize_ - 1;
-    while ((index < size_) && (secondSubPermuteOrder_.at(index) < size_)) {
-      index--;
+    // find the index of the dual element
+    inline uint32_t findDualIndex(uint32_t index) const {
+      // the last element has no dual element when size is odd
+      if ((index == size - 1) && ((size % 2) == 1)) {
+        return static_cast<uint32_t>(-1);
+      }
+      if (index >= firstHalfSize) {
+        return index - firstHalfSize;
+      } else {
+        return index + firstHalfSize;
+      }
     }
-    if (index < size_) {
-      return index + firstHalfSize_;
-    } else {
-      return index;
+
+    // find the corresponding index in the sub permute
+    inline uint32_t findIndexInSubPermute(uint32_t index) const {
+      if (index >= firstHalfSize) {
+        return index - firstHalfSize;
+      } else {
+        return index;
+      }
     }
-  }
 
-  const size_t size_;
-  const size_t firstHalfSize_;
-  const size_t secondHalfSize_;
-  const std::vector<uint32_t>& expectedOrder_;
+    inline uint32_t findAFreeIndex() const {
+      size_t index = secondHalfSize - 1;
+      while ((index < size) && (secondSubPermuteOrder[index] < size)) {
+        index--;
+      }
+      if (index < size) {
+        return index + firstHalfSize;
+      } else {
+        return index;
+      }
+    }
+  };
 
   std::vector<uint32_t> inversedOrder_;
-  std::vector<bool> firstSwapConditions_;
-  std::vector<bool> secondSwapConditions_;
+  std::vector<uint8_t> firstSwapConditions_;
+  std::vector<uint8_t> secondSwapConditions_;
 
   std::vector<uint32_t> firstSubPermuteOrder_;
   std::vector<uint32_t> secondSubPermuteOrder_;
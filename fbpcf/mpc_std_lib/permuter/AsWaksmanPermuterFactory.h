@@ -17,18 +17,19 @@ class AsWaksmanPermuterFactory final
     : public IPermuterFactory<
           typename util::SecBatchType<T, schedulerId>::type> {
  public:
-  AsWaksmanPermuterFactory(int myId, int partnerId)
-      : myId_(myId), partnerId_(partnerId) {}
+  AsWaksmanPermuterFactory(int myId, int partnerId, size_t threadCount = 1)
+      : myId_(myId), partnerId_(partnerId), threadCount_(threadCount) {}
 
   std::unique_ptr<IPermuter<typename util::SecBatchType<T, schedulerId>::type>>
   create() override {
     return std::make_unique<AsWaksmanPermuter<T, schedulerId>>(
-        myId_, partnerId_);
+        myId_, partnerId_, threadCount_);
   }
 
  private:
   int myId_;
   int partnerId_;
+  size_t threadCount_;
 };
 
 } // namespace fbpcf::mpc_std_lib::permuter
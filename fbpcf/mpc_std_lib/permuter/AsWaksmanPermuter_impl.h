@@ -7,6 +7,10 @@
 
 #pragma once
 
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+
 namespace fbpcf::mpc_std_lib::permuter {
 
 template <typename T, int schedulerId>
@@ -16,30 +20,13 @@ AsWaksmanPermuter<T, schedulerId>::permute(const SecBatchType& src, size_t size)
   if (size == 1) {
     return src;
   }
-  if (size == 2) {
-    std::vector<bool> placeHolder(1);
-    return processTwoElements(
-        src, frontend::Bit<true, schedulerId, true>(placeHolder, partnerId_));
-  }
-
-  std::vector<bool> placeHolder(size / 2);
-  frontend::Bit<true, schedulerId, true> firstSwapConditions(
-      placeHolder, partnerId_);
-
-  auto [first, second] =
-      preSubPermutationSwap(src, std::move(firstSwapConditions), size);
-  auto permutedFirst = permute(std::move(first), size / 2);
-  auto permutedSecond = permute(std::move(second), size - size / 2);
-
-  placeHolder.resize((size - 1) / 2);
-  frontend::Bit<true, schedulerId, true> secondSwapConditions(
-      placeHolder, partnerId_);
-
-  return postSubPermutationSwap(
-      std::move(permutedFirst),
-      std::move(permutedSecond),
-      std::move(secondSwapConditions),
-      size);
+  AsWaksmanNetwork network(size);
+  std::vector<bool> placeHolder(network.getSwapCount());
+  return evaluateNetwork(
+      src,
+      size,
+      network,
+      frontend::Bit<true, schedulerId, true>(placeHolder, partnerId_));
 }
 
 template <typename T, int schedulerId>
@@ -48,115 +35,125 @@ AsWaksmanPermuter<T, schedulerId>::permute(
     const SecBatchType& src,
     size_t size,
     const std::vector<uint32_t>& order) const {
+  if (order.size() != size) {
+    throw std::invalid_argument("Inconsistent input size");
+  }
   if (size == 1) {
     return src;
   }
-  if (size == 2) {
-    std::vector<bool> swapChoice(1, order.at(0) == 1);
-    return processTwoElements(
-        src, frontend::Bit<true, schedulerId, true>(swapChoice, myId_));
-  }
-  AsWaksmanParameterCalculator calculator(order);
-
-  frontend::Bit<true, schedulerId, true> firstSwapConditions(
-      calculator.getFirstSwapConditions(), myId_);
-
-  auto [first, second] =
-      preSubPermutationSwap(src, std::move(firstSwapConditions), size);
-
-  auto permutedFirst =
-      permute(std::move(first), size / 2, calculator.getFirstSubPermuteOrder());
-
-  auto permutedSecond = permute(
-      std::move(second),
-      size - size / 2,
-      calculator.getSecondSubPermuteOrder());
-
-  frontend::Bit<true, schedulerId, true> secondSwapConditions(
-      calculator.getSecondSwapConditions(), myId_);
-
-  return postSubPermutationSwap(
-      std::move(permutedFirst),
-      std::move(permutedSecond),
-      std::move(secondSwapConditions),
-      size);
+  AsWaksmanNetwork network(order, threadCount_);
+  return evaluateNetwork(
+      src,
+      size,
+      network,
+      frontend::Bit<true, schedulerId, true>(
+          network.getSwapConditions(), myId_));
 }
 
 template <typename T, int schedulerId>
-std::pair<
-    typename AsWaksmanPermuter<T, schedulerId>::SecBatchType,
-    typename AsWaksmanPermuter<T, schedulerId>::SecBatchType>
-AsWaksmanPermuter<T, schedulerId>::preSubPermutationSwap(
+typename AsWaksmanPermuter<T, schedulerId>::SecBatchType
+AsWaksmanPermuter<T, schedulerId>::evaluateNetwork(
     const SecBatchType& src,
-    frontend::Bit<true, schedulerId, true>&& firstSwapConditions,
-    size_t size) const {
-  // unbatch to 3 pieces if size is odd, 2 pieces if even
-  auto unbatchSize = std::make_shared<std::vector<uint32_t>>(2 + (size & 1));
-  (*unbatchSize)[0] = size / 2;
-  (*unbatchSize)[1] = size / 2;
-  if ((size & 1) == 1) {
-    (*unbatchSize)[2] = 1;
-  }
-  auto batches = src.unbatching(unbatchSize);
-  if ((size & 1) == 0) {
-    return util::MpcAdapters<T, schedulerId>::obliviousSwap(
-        std::move(batches[0]),
-        std::move(batches[1]),
-        std::move(firstSwapConditions));
+    size_t size,
+    const AsWaksmanNetwork& network,
+    frontend::Bit<true, schedulerId, true>&& swapConditions) const {
+  // the conditions of all the layers are input at once.
+  auto& layers = network.getLayers();
+  std::vector<frontend::Bit<true, schedulerId, true>> layerConditions;
+  if (layers.size() == 1) {
+    layerConditions.push_back(std::move(swapConditions));
   } else {
-    auto [first, second] = util::MpcAdapters<T, schedulerId>::obliviousSwap(
-        std::move(batches[0]),
-        std::move(batches[1]),
-        std::move(firstSwapConditions));
-    auto fullSecond = std::move(second).batchingWith({std::move(batches[2])});
-    return {first, fullSecond};
+    layerConditions = swapConditions.unbatching(
+        std::make_shared<std::vector<uint32_t>>(network.getLayerSizes()));
   }
-}
 
-template <typename T, int schedulerId>
-typename AsWaksmanPermuter<T, schedulerId>::SecBatchType
-AsWaksmanPermuter<T, schedulerId>::postSubPermutationSwap(
-    SecBatchType&& src0,
-    SecBatchType&& src1,
-    frontend::Bit<true, schedulerId, true>&& secondSwapConditions,
-    size_t size) const {
-  auto unbatchSize = std::make_shared<std::vector<uint32_t>>(2);
-  (*unbatchSize)[0] = (size - 1) / 2;
-  (*unbatchSize)[1] = 1;
-  auto secondBatches = src1.unbatching(unbatchSize);
-  if ((size & 1) == 0) {
-    auto firstBatches = src0.unbatching(unbatchSize);
-    auto [first, second] = util::MpcAdapters<T, schedulerId>::obliviousSwap(
-        std::move(firstBatches[0]),
-        std::move(secondBatches[0]),
-        std::move(secondSwapConditions));
-    return first.batchingWith(
-        {std::move(firstBatches[1]),
-         std::move(second),
-         std::move(secondBatches[1])});
-  } else {
-    auto [first, second] = util::MpcAdapters<T, schedulerId>::obliviousSwap(
-        std::move(src0),
-        std::move(secondBatches[0]),
-        std::move(secondSwapConditions));
-    return first.batchingWith({std::move(second), std::move(secondBatches[1])});
+  auto rst = src;
+  for (size_t i = 0; i < layers.size(); i++) {
+    rst = evaluateLayer(
+        rst, size, layers.at(i), std::move(layerConditions.at(i)));
   }
+  return rst;
 }
 
 template <typename T, int schedulerId>
 typename AsWaksmanPermuter<T, schedulerId>::SecBatchType
-AsWaksmanPermuter<T, schedulerId>::processTwoElements(
+AsWaksmanPermuter<T, schedulerId>::evaluateLayer(
     const SecBatchType& src,
+    size_t size,
+    const std::vector<AsWaksmanNetwork::SwapGroup>& layer,
     frontend::Bit<true, schedulerId, true>&& swapConditions) const {
-  auto unbatchSize = std::make_shared<std::vector<uint32_t>>(2);
-  (*unbatchSize)[0] = 1;
-  (*unbatchSize)[1] = 1;
-  auto batches = src.unbatching(unbatchSize);
+  // cut the values into the left and right sides of each swap group and the
+  // values in between, which are not swapped in this layer.
+  enum class PieceType { unchanged, left, right };
+  std::vector<PieceType> pieceTypes;
+  auto pieceSizes = std::make_shared<std::vector<uint32_t>>();
+  auto addPiece = [&](PieceType type, uint32_t pieceSize) {
+    if (pieceSize > 0) {
+      pieceTypes.push_back(type);
+      pieceSizes->push_back(pieceSize);
+    }
+  };
+  auto groupSizes = std::make_shared<std::vector<uint32_t>>();
+  uint32_t position = 0;
+  for (auto& group : layer) {
+    addPiece(PieceType::unchanged, group.leftStart - position);
+    addPiece(PieceType::left, group.count);
+    addPiece(
+        PieceType::unchanged, group.rightStart - group.leftStart - group.count);
+    addPiece(PieceType::right, group.count);
+    groupSizes->push_back(group.count);
+    position = group.rightStart + group.count;
+  }
+  addPiece(PieceType::unchanged, size - position);
+
+  auto pieces = src.unbatching(pieceSizes);
+  std::vector<SecBatchType> lefts;
+  std::vector<SecBatchType> rights;
+  for (size_t i = 0; i < pieces.size(); i++) {
+    if (pieceTypes.at(i) == PieceType::left) {
+      lefts.push_back(std::move(pieces.at(i)));
+    } else if (pieceTypes.at(i) == PieceType::right) {
+      rights.push_back(std::move(pieces.at(i)));
+    }
+  }
 
-  auto [first, second] = util::MpcAdapters<T, schedulerId>::obliviousSwap(
-      std::move(batches[0]), std::move(batches[1]), swapConditions);
+  auto [swappedLeft, swappedRight] =
+      util::MpcAdapters<T, schedulerId>::obliviousSwap(
+          concatenate(std::move(lefts)),
+          concatenate(std::move(rights)),
+          std::move(swapConditions));
 
-  return first.batchingWith({std::move(second)});
+  // put the swapped values back in place.
+  if (layer.size() == 1) {
+    lefts = {std::move(swappedLeft)};
+    rights = {std::move(swappedRight)};
+  } else {
+    lefts = swappedLeft.unbatching(groupSizes);
+    rights = swappedRight.unbatching(groupSizes);
+  }
+  size_t leftIndex = 0;
+  size_t rightIndex = 0;
+  for (size_t i = 0; i < pieces.size(); i++) {
+    if (pieceTypes.at(i) == PieceType::left) {
+      pieces[i] = std::move(lefts.at(leftIndex++));
+    } else if (pieceTypes.at(i) == PieceType::right) {
+      pieces[i] = std::move(rights.at(rightIndex++));
+    }
+  }
+  return concatenate(std::move(pieces));
+}
+
+template <typename T, int schedulerId>
+typename AsWaksmanPermuter<T, schedulerId>::SecBatchType
+AsWaksmanPermuter<T, schedulerId>::concatenate(
+    std::vector<SecBatchType>&& batches) {
+  if (batches.size() == 1) {
+    return std::move(batches.at(0));
+  }
+  std::vector<SecBatchType> others(
+      std::make_move_iterator(batches.begin() + 1),
+      std::make_move_iterator(batches.end()));
+  return batches.at(0).batchingWith(others);
 }
 
 } // namespace fbpcf::mpc_std_lib::permuter
@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "fbpcf/frontend/BitString.h"
+#include "fbpcf/mpc_std_lib/permuter/IPermuter.h"
+
+namespace fbpcf::mpc_std_lib::permuter {
+
+/**
+ * A permutation correlation of size values of width bits. One party, the
+ * owner, holds a random permutation s and delta; the other party holds a
+ * random mask a and b, such that delta ^ b = s(a), i.e.
+ * delta[i][j] ^ b[i][j] = a[i][s[j]].
+ */
+struct PermutationCorrelation {
+  // only known by the owner.
+  std::vector<uint32_t> permutation;
+  // only known by the other party, [bit][value].
+  std::vector<std::vector<bool>> mask;
+  // delta for the owner, b for the other party, [bit][value].
+  std::vector<std::vector<bool>> share;
+};
+
+/**
+ * Create permutation correlations by running an underlying permuter on random
+ * masks, and keep them in pools until they are used. Both parties need to
+ * create and take the correlations in the same order.
+ */
+template <int schedulerId>
+class PermutationCorrelationGenerator {
+ public:
+  using SecString = frontend::BitString<true, schedulerId, true>;
+
+  PermutationCorrelationGenerator(
+      int myId,
+      int partnerId,
+      std::unique_ptr<IPermuter<SecString>> permuter)
+      : myId_(myId), partnerId_(partnerId), permuter_(std::move(permuter)) {}
+
+  /**
+   * Create count correlations of each owner for size values of width bits,
+   * first those owned by the party with the smaller id.
+   */
+  void preprocess(size_t size, size_t width, size_t count);
+
+  /**
+   * Take a correlation of the given shape, creating it if there is none left.
+   */
+  PermutationCorrelation take(size_t size, size_t width, bool amIOwner);
+
+ private:
+  using Shape = std::pair<size_t, size_t>;
+
+  // the number of blocks the prg generates at a time.
+  static const int kPrgBufferSize = 1024;
+
+  PermutationCorrelation generate(size_t size, size_t width, bool amIOwner);
+
+  int myId_;
+  int partnerId_;
+  std::unique_ptr<IPermuter<SecString>> permuter_;
+
+  // the correlations of each shape owned by this party or by the partner.
+  std::map<Shape, std::deque<PermutationCorrelation>> myCorrelations_;
+  std::map<Shape, std::deque<PermutationCorrelation>> partnerCorrelations_;
+};
+
+} // namespace fbpcf::mpc_std_lib::permuter
+
+#include "fbpcf/mpc_std_lib/permuter/PermutationCorrelationGenerator_impl.h"
@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <stdexcept>
+#include <utility>
+#include "fbpcf/engine/util/AesPrg.h"
+#include "fbpcf/engine/util/util.h"
+
+namespace fbpcf::mpc_std_lib::permuter {
+
+template <int schedulerId>
+void PermutationCorrelationGenerator<schedulerId>::preprocess(
+    size_t size,
+    size_t width,
+    size_t count) {
+  if ((size == 0) || (width == 0)) {
+    throw std::invalid_argument("Empty input!");
+  }
+  bool isFirstOwner = myId_ < partnerId_;
+  for (auto amIOwner : {isFirstOwner, !isFirstOwner}) {
+    auto& queue = amIOwner ? myCorrelations_[{size, width}]
+                           : partnerCorrelations_[{size, width}];
+    for (size_t i = 0; i < count; i++) {
+      queue.push_back(generate(size, width, amIOwner));
+    }
+  }
+}
+
+template <int schedulerId>
+PermutationCorrelation PermutationCorrelationGenerator<schedulerId>::take(
+    size_t size,
+    size_t width,
+    bool amIOwner) {
+  if ((size == 0) || (width == 0)) {
+    throw std::invalid_argument("Empty input!");
+  }
+  auto& queue = amIOwner ? myCorrelations_[{size, width}]
+                         : partnerCorrelations_[{size, width}];
+  if (queue.empty()) {
+    queue.push_back(generate(size, width, amIOwner));
+  }
+  auto rst = std::move(queue.front());
+  queue.pop_front();
+  return rst;
+}
+
+template <int schedulerId>
+PermutationCorrelation PermutationCorrelationGenerator<schedulerId>::generate(
+    size_t size,
+    size_t width,
+    bool amIOwner) {
+  engine::util::AesPrg prg(
+      engine::util::getRandomM128iFromSystemNoise(), kPrgBufferSize);
+  PermutationCorrelation rst;
+  // the values to permute, [value][bit]. Only the party that does not own the
+  // correlation provides them.
+  std::vector<std::vector<bool>> values(size, std::vector<bool>(width));
+  SecString permuted;
+  if (amIOwner) {
+    rst.permutation = util::generateRandomPermutation(prg, size);
+    permuted = permuter_->permute(
+        SecString(values, partnerId_), size, rst.permutation);
+  } else {
+    rst.mask = std::vector<std::vector<bool>>(width, std::vector<bool>(size));
+    for (auto& item : rst.mask) {
+      prg.getRandomBitsInPlace(item);
+    }
+    for (size_t i = 0; i < width; i++) {
+      for (size_t j = 0; j < size; j++) {
+        values[j][i] = rst.mask.at(i).at(j);
+      }
+    }
+    permuted = permuter_->permute(SecString(values, myId_), size);
+  }
+
+  auto shares = permuted.extractStringShare();
+  rst.share = std::vector<std::vector<bool>>(width);
+  for (size_t i = 0; i < width; i++) {
+    rst.share[i] = shares[i].getValue();
+  }
+  return rst;
+}
+
+} // namespace fbpcf::mpc_std_lib::permuter
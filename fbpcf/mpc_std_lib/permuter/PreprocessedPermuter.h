@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "fbpcf/engine/communication/IPartyCommunicationAgent.h"
+#include "fbpcf/frontend/BitString.h"
+#include "fbpcf/mpc_std_lib/permuter/IPermuter.h"
+#include "fbpcf/mpc_std_lib/permuter/PermutationCorrelationGenerator.h"
+
+namespace fbpcf::mpc_std_lib::permuter {
+
+/**
+ * A permuter that moves all the interaction ahead of time. In the offline
+ * phase, the party that will choose the order picks a random permutation s and
+ * the other party a random mask a; the underlying permuter then gives the first
+ * party delta and the second party b such that delta ^ b = s(a). In the online
+ * phase, the second party sends its share of the values masked with a, and the
+ * first party sends the order composed with the inverse of s, which reveals
+ * nothing about the order. Both messages are sent at the same time and the
+ * rest is local work that is linear in the size of the values.
+ */
+template <int schedulerId>
+class PreprocessedPermuter final
+    : public IPermuter<frontend::BitString<true, schedulerId, true>> {
+ public:
+  using SecString = frontend::BitString<true, schedulerId, true>;
+
+  /**
+   * @param permuter the permuter that creates the correlations in the offline
+   * phase.
+   */
+  PreprocessedPermuter(
+      int myId,
+      int partnerId,
+      std::unique_ptr<IPermuter<SecString>> permuter,
+      std::unique_ptr<engine::communication::IPartyCommunicationAgent> agent)
+      : generator_(
+            std::make_unique<PermutationCorrelationGenerator<schedulerId>>(
+                myId,
+                partnerId,
+                std::move(permuter))),
+        agent_(std::move(agent)) {}
+
+  /**
+   * Create the correlations for a number of future permutations of size values
+   * of width bits, for each of the two parties choosing the order. Both parties
+   * need to call this with the same parameters at the same time. Any
+   * correlations that are not preprocessed will be created on demand.
+   */
+  void preprocess(size_t size, size_t width, size_t count) const {
+    generator_->preprocess(size, width, count);
+  }
+
+  SecString permute(const SecString& src, size_t size) const override;
+
+  SecString permute(
+      const SecString& src,
+      size_t size,
+      const std::vector<uint32_t>& order) const override;
+
+ private:
+  std::unique_ptr<PermutationCorrelationGenerator<schedulerId>> generator_;
+  std::unique_ptr<engine::communication::IPartyCommunicationAgent> agent_;
+};
+
+} // namespace fbpcf::mpc_std_lib::permuter
+
+#include "fbpcf/mpc_std_lib/permuter/PreprocessedPermuter_impl.h"
@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <memory>
+#include "fbpcf/engine/communication/IPartyCommunicationAgentFactory.h"
+#include "fbpcf/mpc_std_lib/permuter/IPermuterFactory.h"
+#include "fbpcf/mpc_std_lib/permuter/PreprocessedPermuter.h"
+
+namespace fbpcf::mpc_std_lib::permuter {
+
+template <int schedulerId>
+class PreprocessedPermuterFactory final
+    : public IPermuterFactory<frontend::BitString<true, schedulerId, true>> {
+ public:
+  /**
+   * @param permuterFactory the factory of the permuters that create the
+   * correlations in the offline phase.
+   */
+  PreprocessedPermuterFactory(
+      int myId,
+      int partnerId,
+      engine::communication::IPartyCommunicationAgentFactory& factory,
+      std::unique_ptr<
+          IPermuterFactory<frontend::BitString<true, schedulerId, true>>>
+          permuterFactory)
+      : myId_(myId),
+        partnerId_(partnerId),
+        factory_(factory),
+        permuterFactory_(std::move(permuterFactory)) {}
+
+  std::unique_ptr<IPermuter<frontend::BitString<true, schedulerId, true>>>
+  create() override {
+    return std::make_unique<PreprocessedPermuter<schedulerId>>(
+        myId_,
+        partnerId_,
+        permuterFactory_->create(),
+        factory_.create(partnerId_));
+  }
+
+ private:
+  int myId_;
+  int partnerId_;
+  engine::communication::IPartyCommunicationAgentFactory& factory_;
+  std::unique_ptr<
+      IPermuterFactory<frontend::BitString<true, schedulerId, true>>>
+      permuterFactory_;
+};
+
+} // namespace fbpcf::mpc_std_lib::permuter
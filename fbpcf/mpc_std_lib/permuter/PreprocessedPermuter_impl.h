@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <stdexcept>
+
+namespace fbpcf::mpc_std_lib::permuter {
+
+template <int schedulerId>
+typename PreprocessedPermuter<schedulerId>::SecString
+PreprocessedPermuter<schedulerId>::permute(const SecString& src, size_t size)
+    const {
+  if (size == 1) {
+    return src;
+  }
+  auto width = src.size();
+  auto correlation = generator_->take(size, width, false);
+
+  // send this party's shares masked with the mask of the correlation.
+  auto shares = src.extractStringShare();
+  std::vector<bool> maskedShares(width * size);
+  for (size_t i = 0; i < width; i++) {
+    auto share = shares[i].getValue();
+    if (share.size() != size) {
+      throw std::invalid_argument("Inconsistent input size");
+    }
+    for (size_t j = 0; j < size; j++) {
+      maskedShares[i * size + j] = share.at(j) ^ correlation.mask.at(i).at(j);
+    }
+  }
+  agent_->sendBool(maskedShares);
+  auto correction = agent_->receiveT<uint32_t>(size);
+
+  std::vector<std::vector<bool>> rst(width, std::vector<bool>(size));
+  for (size_t i = 0; i < width; i++) {
+    auto& share = correlation.share.at(i);
+    for (size_t j = 0; j < size; j++) {
+      rst[i][j] = share.at(correction.at(j));
+    }
+  }
+  return SecString(typename SecString::ExtractedString(rst));
+}
+
+template <int schedulerId>
+typename PreprocessedPermuter<schedulerId>::SecString
+PreprocessedPermuter<schedulerId>::permute(
+    const SecString& src,
+    size_t size,
+    const std::vector<uint32_t>& order) const {
+  if (order.size() != size) {
+    throw std::invalid_argument("Inconsistent input size");
+  }
+  if (size == 1) {
+    return src;
+  }
+  auto width = src.size();
+  auto correlation = generator_->take(size, width, true);
+
+  // the order composed with the inverse of the random permutation, such that
+  // permutation[correction[j]] = order[j].
+  std::vector<uint32_t> inverse(size);
+  for (size_t j = 0; j < size; j++) {
+    inverse[correlation.permutation.at(j)] = j;
+  }
+  std::vector<uint32_t> correction(size);
+  for (size_t j = 0; j < size; j++) {
+    correction[j] = inverse.at(order.at(j));
+  }
+  agent_->sendT<uint32_t>(correction);
+  auto maskedShares = agent_->receiveBool(width * size);
+
+  // the masked values permuted to the order, plus delta permuted to the order
+  // too, which removes the masks.
+  auto shares = src.extractStringShare();
+  std::vector<std::vector<bool>> rst(width, std::vector<bool>(size));
+  for (size_t i = 0; i < width; i++) {
+    auto share = shares[i].getValue();
+    if (share.size() != size) {
+      throw std::invalid_argument("Inconsistent input size");
+    }
+    auto& delta = correlation.share.at(i);
+    for (size_t j = 0; j < size; j++) {
+      auto position = order.at(j);
+      rst[i][j] = share.at(position) ^ maskedShares.at(i * size + position) ^
+          delta.at(correction.at(j));
+    }
+  }
+  return SecString(typename SecString::ExtractedString(rst));
+}
+
+} // namespace fbpcf::mpc_std_lib::permuter
@@ -17,6 +17,7 @@
 #include "fbpcf/mpc_std_lib/permuter/AsWaksmanPermuter.h"
 #include "fbpcf/mpc_std_lib/permuter/AsWaksmanPermuterFactory.h"
 #include "fbpcf/mpc_std_lib/permuter/DummyPermuterFactory.h"
+#include "fbpcf/mpc_std_lib/permuter/PreprocessedPermuterFactory.h"
 #include "fbpcf/mpc_std_lib/util/test/util.h"
 #include "fbpcf/mpc_std_lib/util/util.h"
 #include "fbpcf/scheduler/SchedulerHelper.h"
@@ -100,6 +101,59 @@ TEST(permuterTest, testAsWaksmanPermuter) {
   permuterTest(factory0, factory1);
 }
 
+TEST(permuterTest, testAsWaksmanPermuterWithThreads) {
+  AsWaksmanPermuterFactory<std::vector<bool>, 0> factory0(0, 1, 4);
+  AsWaksmanPermuterFactory<std::vector<bool>, 1> factory1(1, 0, 4);
+
+  permuterTest(factory0, factory1);
+}
+
+TEST(permuterTest, testPreprocessedPermuter) {
+  auto agentFactories = engine::communication::getInMemoryAgentFactory(2);
+  PreprocessedPermuterFactory<0> factory0(
+      0,
+      1,
+      *agentFactories[0],
+      std::make_unique<AsWaksmanPermuterFactory<std::vector<bool>, 0>>(0, 1));
+  PreprocessedPermuterFactory<1> factory1(
+      1,
+      0,
+      *agentFactories[1],
+      std::make_unique<AsWaksmanPermuterFactory<std::vector<bool>, 1>>(1, 0));
+
+  // correlations created on demand
+  permuterTest(factory0, factory1);
+
+  // correlations created ahead of time
+  auto agentFactories2 = engine::communication::getInMemoryAgentFactory(2);
+  setupRealBackend<0, 1>(*agentFactories2[0], *agentFactories2[1]);
+  PreprocessedPermuter<0> permuter0(
+      0,
+      1,
+      std::make_unique<AsWaksmanPermuter<std::vector<bool>, 0>>(0, 1),
+      agentFactories[0]->create(1));
+  PreprocessedPermuter<1> permuter1(
+      1,
+      0,
+      std::make_unique<AsWaksmanPermuter<std::vector<bool>, 1>>(1, 0),
+      agentFactories[1]->create(0));
+  size_t size = 23;
+  auto [originalData, order, expectedOutput] = getPermuterTestData(size);
+  auto future0 = std::async([&]() {
+    permuter0.preprocess(size, 32, 1);
+    frontend::BitString<true, 0, true> bits(originalData, 0);
+    return permuter0.permute(bits, size, order).openToParty(0).getValue();
+  });
+  auto future1 = std::async([&]() {
+    permuter1.preprocess(size, 32, 1);
+    frontend::BitString<true, 1, true> bits(originalData, 0);
+    permuter1.permute(bits, size).openToParty(0);
+  });
+  auto rst = future0.get();
+  future1.get();
+  testVectorEq(rst, expectedOutput);
+}
+
 void testAsWaksmanParameter() {
   std::random_device rd;
   std::mt19937_64 e(rd());
@@ -166,4 +220,46 @@ TEST(AsWaksmanParameterTest, testAsWaksmanParameterCalculator) {
   }
 }
 
+void testAsWaksmanNetwork(size_t size) {
+  auto order = util::generateRandomPermutation(size);
+  AsWaksmanNetwork network(order);
+  AsWaksmanNetwork layout(size);
+  EXPECT_EQ(network.getSwapCount(), layout.getSwapCount());
+  EXPECT_EQ(network.getLayerSizes(), layout.getLayerSizes());
+  EXPECT_LE(network.getLayers().size(), 2 * std::ceil(std::log2(size)));
+
+  std::vector<uint32_t> testData(size);
+  for (size_t i = 0; i < size; i++) {
+    testData[i] = i;
+  }
+  auto conditions = network.getSwapConditions();
+  ASSERT_EQ(conditions.size(), network.getSwapCount());
+  // routing the subnetworks in parallel gives the same network.
+  EXPECT_EQ(AsWaksmanNetwork(order, 4).getSwapConditions(), conditions);
+  size_t index = 0;
+  for (auto& layer : network.getLayers()) {
+    for (auto& group : layer) {
+      for (size_t i = 0; i < group.count; i++) {
+        if (conditions.at(index++)) {
+          std::swap(
+              testData[group.leftStart + i], testData[group.rightStart + i]);
+        }
+      }
+    }
+  }
+  testVectorEq(testData, order);
+}
+
+TEST(AsWaksmanParameterTest, testAsWaksmanNetwork) {
+  std::random_device rd;
+  std::mt19937_64 e(rd());
+  std::uniform_int_distribution<uint32_t> randomSize(2, 0xFFF);
+  for (size_t size : {2, 3, 4, 5, 8, 1024}) {
+    testAsWaksmanNetwork(size);
+  }
+  for (size_t i = 0; i < 100; i++) {
+    testAsWaksmanNetwork(randomSize(e));
+  }
+}
+
 } // namespace fbpcf::mpc_std_lib::permuter
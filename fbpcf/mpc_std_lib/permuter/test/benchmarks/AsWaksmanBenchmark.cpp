@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <folly/Benchmark.h>
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <vector>
+#include "common/init/Init.h"
+
+#include "fbpcf/mpc_std_lib/permuter/AsWaksmanPermuter.h"
+#include "folly/BenchmarkUtil.h"
+
+namespace fbpcf::mpc_std_lib::permuter {
+
+DEFINE_int64(
+    AsWaksman_Benchmark_Size,
+    1 << 22,
+    "The size of the permutations to compute the AS-Waksman network for");
+
+std::vector<uint32_t> generateOrder() {
+  std::vector<uint32_t> order(FLAGS_AsWaksman_Benchmark_Size);
+  std::iota(order.begin(), order.end(), 0);
+  std::random_device rd;
+  std::mt19937_64 e(rd());
+  std::shuffle(order.begin(), order.end(), e);
+  return order;
+}
+
+BENCHMARK(AsWaksmanNetwork_layOut, n) {
+  while (n--) {
+    AsWaksmanNetwork network(FLAGS_AsWaksman_Benchmark_Size);
+    folly::doNotOptimizeAway(network.getSwapCount());
+  }
+}
+
+void AsWaksmanNetwork_route(uint32_t n, size_t threadCount) {
+  folly::BenchmarkSuspender braces;
+  auto order = generateOrder();
+  braces.dismiss();
+
+  while (n--) {
+    AsWaksmanNetwork network(order, threadCount);
+    folly::doNotOptimizeAway(network.getSwapConditions());
+  }
+}
+
+BENCHMARK_PARAM(AsWaksmanNetwork_route, 1)
+BENCHMARK_RELATIVE_PARAM(AsWaksmanNetwork_route, 2)
+BENCHMARK_RELATIVE_PARAM(AsWaksmanNetwork_route, 4)
+BENCHMARK_RELATIVE_PARAM(AsWaksmanNetwork_route, 8)
+BENCHMARK_RELATIVE_PARAM(AsWaksmanNetwork_route, 16)
+} // namespace fbpcf::mpc_std_lib::permuter
+
+int main(int argc, char* argv[]) {
+  facebook::initFacebook(&argc, &argv);
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  folly::runBenchmarks();
+  return 0;
+}
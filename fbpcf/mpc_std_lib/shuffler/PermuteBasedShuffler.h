@@ -31,7 +31,7 @@ class PermuteBasedShuffler final : public IShuffler<T> {
         prg_(std::move(prg)) {}
 
   T shuffle(const T& src, size_t size) const override {
-    auto myRandomPermutation = generateRandomPermutation(size);
+    auto myRandomPermutation = util::generateRandomPermutation(*prg_, size);
     if (myId_ < partnerId_) {
       auto tmp = permuter_->permute(src, size, myRandomPermutation);
       auto rst = permuter_->permute(std::move(tmp), size);
@@ -44,20 +44,6 @@ class PermuteBasedShuffler final : public IShuffler<T> {
   }
 
  private:
-  std::vector<uint32_t> generateRandomPermutation(size_t size) const {
-    std::vector<uint32_t> rst(size);
-    for (size_t i = 0; i < size; i++) {
-      rst[i] = i;
-    }
-    for (size_t i = size; i > 0; i--) {
-      auto randomBytes = prg_->getRandomBytes(8);
-      auto tmp = reinterpret_cast<uint64_t*>(randomBytes.data());
-      auto position = (*tmp) % i;
-      std::swap(rst[position], rst[i - 1]);
-    }
-    return rst;
-  }
-
   int myId_;
   int partnerId_;
   std::unique_ptr<permuter::IPermuter<T>> permuter_;
@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "fbpcf/engine/communication/IPartyCommunicationAgent.h"
+#include "fbpcf/frontend/BitString.h"
+#include "fbpcf/mpc_std_lib/permuter/IPermuter.h"
+#include "fbpcf/mpc_std_lib/permuter/PermutationCorrelationGenerator.h"
+#include "fbpcf/mpc_std_lib/shuffler/IShuffler.h"
+
+namespace fbpcf::mpc_std_lib::shuffler {
+
+/**
+ * A shuffler that permutes the values with a random permutation of each party
+ * in turn, using one permutation correlation for each. To permute with its
+ * permutation s, the owner of a correlation receives the other party's shares
+ * masked with a, permutes them together with its own shares by s, and adds
+ * delta; the other party's new shares are b. Each turn is one message of
+ * size * width bits, so the online phase is linear in the size of the values
+ * and has no AND gates. Only the online phase is: the correlations are created
+ * by running the underlying permuter (e.g. AS-Waksman) on random masks, ahead
+ * of time with preprocess() or on demand, so the total cost is that of the
+ * permuter plus the linear online phase. This shuffler moves the permuter's
+ * cost offline; it doesn't reduce it, which is why it has no shuffler factory
+ * and needs to be constructed directly.
+ */
+template <int schedulerId>
+class ResharingShuffler final
+    : public IShuffler<frontend::BitString<true, schedulerId, true>> {
+ public:
+  using SecString = frontend::BitString<true, schedulerId, true>;
+
+  /**
+   * @param permuter the permuter that creates the correlations.
+   */
+  ResharingShuffler(
+      int myId,
+      int partnerId,
+      std::unique_ptr<permuter::IPermuter<SecString>> permuter,
+      std::unique_ptr<engine::communication::IPartyCommunicationAgent> agent)
+      : myId_(myId),
+        partnerId_(partnerId),
+        generator_(std::make_unique<
+                   permuter::PermutationCorrelationGenerator<schedulerId>>(
+            myId,
+            partnerId,
+            std::move(permuter))),
+        agent_(std::move(agent)) {}
+
+  /**
+   * Create the correlations for a number of future shuffles of size values of
+   * width bits. Both parties need to call this with the same parameters at the
+   * same time.
+   */
+  void preprocess(size_t size, size_t width, size_t count) const {
+    generator_->preprocess(size, width, count);
+  }
+
+  SecString shuffle(const SecString& src, size_t size) const override;
+
+ private:
+  // permute this party's shares with the random permutation of the owner of
+  // the next correlation and reshare them, [bit][value].
+  std::vector<std::vector<bool>> reshare(
+      std::vector<std::vector<bool>>&& shares,
+      size_t size,
+      bool amIOwner) const;
+
+  int myId_;
+  int partnerId_;
+  std::unique_ptr<permuter::PermutationCorrelationGenerator<schedulerId>>
+      generator_;
+  std::unique_ptr<engine::communication::IPartyCommunicationAgent> agent_;
+};
+
+} // namespace fbpcf::mpc_std_lib::shuffler
+
+#include "fbpcf/mpc_std_lib/shuffler/ResharingShuffler_impl.h"
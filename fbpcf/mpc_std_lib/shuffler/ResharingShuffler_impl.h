@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <stdexcept>
+
+namespace fbpcf::mpc_std_lib::shuffler {
+
+template <int schedulerId>
+typename ResharingShuffler<schedulerId>::SecString
+ResharingShuffler<schedulerId>::shuffle(const SecString& src, size_t size)
+    const {
+  if (size <= 1) {
+    return src;
+  }
+  auto extracted = src.extractStringShare();
+  std::vector<std::vector<bool>> shares(extracted.size());
+  for (size_t i = 0; i < shares.size(); i++) {
+    shares[i] = extracted[i].getValue();
+    if (shares.at(i).size() != size) {
+      throw std::invalid_argument("Inconsistent input size");
+    }
+  }
+  // the party with the smaller id permutes first.
+  bool isFirstOwner = myId_ < partnerId_;
+  shares = reshare(std::move(shares), size, isFirstOwner);
+  shares = reshare(std::move(shares), size, !isFirstOwner);
+  return SecString(typename SecString::ExtractedString(shares));
+}
+
+template <int schedulerId>
+std::vector<std::vector<bool>> ResharingShuffler<schedulerId>::reshare(
+    std::vector<std::vector<bool>>&& shares,
+    size_t size,
+    bool amIOwner) const {
+  auto width = shares.size();
+  auto correlation = generator_->take(size, width, amIOwner);
+  if (!amIOwner) {
+    std::vector<bool> maskedShares(width * size);
+    for (size_t i = 0; i < width; i++) {
+      for (size_t j = 0; j < size; j++) {
+        maskedShares[i * size + j] =
+            shares.at(i).at(j) ^ correlation.mask.at(i).at(j);
+      }
+    }
+    agent_->sendBool(maskedShares);
+    return std::move(correlation.share);
+  }
+
+  // the other party keeps b, and since delta ^ b = s(a), the new shares add up
+  // to x[s[j]] ^ a[s[j]] ^ delta[j] ^ b[j] = x[s[j]].
+  auto maskedShares = agent_->receiveBool(width * size);
+  auto& permutation = correlation.permutation;
+  std::vector<std::vector<bool>> rst(width, std::vector<bool>(size));
+  for (size_t i = 0; i < width; i++) {
+    auto& share = shares.at(i);
+    auto& delta = correlation.share.at(i);
+    for (size_t j = 0; j < size; j++) {
+      auto position = permutation.at(j);
+      rst[i][j] = share.at(position) ^ maskedShares.at(i * size + position) ^
+          delta.at(j);
+    }
+  }
+  return rst;
+}
+
+} // namespace fbpcf::mpc_std_lib::shuffler
@@ -19,6 +19,7 @@
 #include "fbpcf/mpc_std_lib/permuter/DummyPermuterFactory.h"
 #include "fbpcf/mpc_std_lib/shuffler/NonShufflerFactory.h"
 #include "fbpcf/mpc_std_lib/shuffler/PermuteBasedShufflerFactory.h"
+#include "fbpcf/mpc_std_lib/shuffler/ResharingShuffler.h"
 #include "fbpcf/mpc_std_lib/util/test/util.h"
 #include "fbpcf/mpc_std_lib/util/util.h"
 #include "fbpcf/scheduler/SchedulerHelper.h"
@@ -108,4 +109,38 @@ TEST(shufflerTest, testPermuteBasedShufflerWithAsWaksmanPermuter) {
   shufflerTest(factory0, factory1);
 }
 
+TEST(shufflerTest, testResharingShuffler) {
+  auto agentFactories = engine::communication::getInMemoryAgentFactory(2);
+  setupRealBackend<0, 1>(*agentFactories[0], *agentFactories[1]);
+  auto shuffler0 = std::make_unique<ResharingShuffler<0>>(
+      0,
+      1,
+      permuter::AsWaksmanPermuterFactory<std::vector<bool>, 0>(0, 1).create(),
+      agentFactories[0]->create(1));
+  auto shuffler1 = std::make_unique<ResharingShuffler<1>>(
+      1,
+      0,
+      permuter::AsWaksmanPermuterFactory<std::vector<bool>, 1>(1, 0).create(),
+      agentFactories[1]->create(0));
+  size_t size = 16;
+  auto data = util::generateRandomPermutation(size);
+  std::vector<std::vector<bool>> bitData(size);
+  for (size_t i = 0; i < size; i++) {
+    bitData[i] = util::Adapters<uint32_t>::convertToBits(data.at(i));
+  }
+  auto future0 = std::async(task<0>, std::move(shuffler0), bitData);
+  auto future1 = std::async(task<1>, std::move(shuffler1), bitData);
+  auto bitRst = future0.get();
+  future1.get();
+  ASSERT_EQ(data.size(), bitRst.size());
+  std::vector<uint32_t> rst(size);
+  for (size_t i = 0; i < size; i++) {
+    rst[i] = util::Adapters<uint32_t>::convertFromBits(bitRst.at(i));
+  }
+  EXPECT_NE(data, rst);
+  std::sort(rst.begin(), rst.end());
+  std::sort(data.begin(), data.end());
+  EXPECT_EQ(data, rst);
+}
+
 } // namespace fbpcf::mpc_std_lib::shuffler
@@ -216,6 +216,12 @@ class MpcAdapters<Intp<isSigned, width>, schedulerId> {
     return {rst1, rst2};
   }
 
+  static SecBatchType batchingWith(
+      const SecBatchType& src,
+      const std::vector<SecBatchType>& others) {
+    return src.batchingWith(others);
+  }
+
   static std::vector<Intp<isSigned, width>> openToParty(
       const SecBatchType& src,
       int partyId) {
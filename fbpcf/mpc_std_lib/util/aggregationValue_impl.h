@@ -12,6 +12,7 @@
 #include <functional>
 #include <random>
 #include <stdexcept>
+#include <type_traits>
 
 namespace fbpcf::mpc_std_lib::util {
 
@@ -95,6 +96,61 @@ class Adapters<AggregationValue> {
   }
 };
 
+// converts two keys at a time. Each key gives the count from its second lowest
+// 32 bits and the value from its lowest 32 bits, as in generateFromKey.
+template <>
+class BulkAdapters<AggregationValue> {
+  static_assert(
+      sizeof(AggregationValue) == 2 * sizeof(uint32_t) &&
+          std::is_standard_layout_v<AggregationValue>,
+      "AggregationValue must be two packed uint32_t.");
+
+ public:
+  static void generateFromKeys(
+      const __m128i* keys,
+      size_t size,
+      AggregationValue* dst) {
+    size_t i = 0;
+    for (; i + 2 <= size; i += 2) {
+      _mm_storeu_si128(
+          reinterpret_cast<__m128i*>(dst + i), getCountAndValue(keys + i));
+    }
+    for (; i < size; i++) {
+      dst[i] = Adapters<AggregationValue>::generateFromKey(keys[i]);
+    }
+  }
+
+  static AggregationValue addMasksFromKeys(
+      const __m128i* keys,
+      size_t size,
+      AggregationValue* dst) {
+    auto sum = _mm_setzero_si128();
+    size_t i = 0;
+    for (; i + 2 <= size; i += 2) {
+      auto masks = getCountAndValue(keys + i);
+      auto memory = reinterpret_cast<__m128i*>(dst + i);
+      _mm_storeu_si128(memory, _mm_add_epi32(_mm_loadu_si128(memory), masks));
+      sum = _mm_add_epi32(sum, masks);
+    }
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+    AggregationValue rst(_mm_extract_epi32(sum, 0), _mm_extract_epi32(sum, 1));
+    for (; i < size; i++) {
+      auto mask = Adapters<AggregationValue>::generateFromKey(keys[i]);
+      dst[i] += mask;
+      rst += mask;
+    }
+    return rst;
+  }
+
+ private:
+  // the masks of keys[0] and keys[1], laid out as two AggregationValues.
+  static __m128i getCountAndValue(const __m128i* keys) {
+    return _mm_unpacklo_epi64(
+        _mm_shuffle_epi32(keys[0], _MM_SHUFFLE(3, 2, 0, 1)),
+        _mm_shuffle_epi32(keys[1], _MM_SHUFFLE(3, 2, 0, 1)));
+  }
+};
+
 template <int schedulerId>
 struct SecretAggregationValue {
   SecretAggregationValue() = default;
@@ -238,6 +294,23 @@ class MpcAdapters<AggregationValue, schedulerId> {
     return {rst1, rst2};
   }
 
+  static SecBatchType batchingWith(
+      const SecBatchType& src,
+      const std::vector<SecBatchType>& others) {
+    std::vector<decltype(src.conversionCount)> counts;
+    std::vector<decltype(src.conversionValue)> values;
+    counts.reserve(others.size());
+    values.reserve(others.size());
+    for (auto& item : others) {
+      counts.push_back(item.conversionCount);
+      values.push_back(item.conversionValue);
+    }
+    SecretAggregationValue<schedulerId> rst;
+    rst.conversionCount = src.conversionCount.batchingWith(counts);
+    rst.conversionValue = src.conversionValue.batchingWith(values);
+    return rst;
+  }
+
   static std::vector<AggregationValue> openToParty(
       const SecBatchType& src,
       int partyId) {
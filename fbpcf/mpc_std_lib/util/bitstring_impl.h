@@ -40,6 +40,12 @@ class MpcAdapters<std::vector<bool>, schedulerId> {
     return {rst1, rst2};
   }
 
+  static SecBatchType batchingWith(
+      const SecBatchType& src,
+      const std::vector<SecBatchType>& others) {
+    return src.batchingWith(others);
+  }
+
   static std::vector<std::vector<bool>> openToParty(
       const SecBatchType& src,
       int partyId);
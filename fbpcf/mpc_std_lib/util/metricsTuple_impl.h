@@ -0,0 +1,415 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <emmintrin.h>
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include "fbpcf/engine/util/aes.h"
+
+namespace fbpcf::mpc_std_lib::util {
+
+/**
+ * functions added here are helpers to support a write-only ORAM for values
+ * made of several metrics, e.g. the count, the sum and the sum of squares of
+ * the conversions in a bucket. A single ORAM write then updates all the
+ * metrics with one index tree expansion, instead of one ORAM per metric. Each
+ * metric type must have Adapters and MpcAdapters, e.g. uint32_t or Intp.
+ */
+
+template <typename... Metrics>
+struct MetricsTuple {
+  static_assert(sizeof...(Metrics) > 0, "There must be at least one metric.");
+
+  std::tuple<Metrics...> metrics;
+
+  MetricsTuple() = default;
+
+  // all metrics are set to the same value, e.g. MetricsTuple(0) is zero.
+  explicit MetricsTuple(int value) : metrics{Metrics(value)...} {}
+
+  explicit MetricsTuple(Metrics... values) : metrics{values...} {}
+
+  template <size_t i>
+  auto& get() {
+    return std::get<i>(metrics);
+  }
+
+  template <size_t i>
+  const auto& get() const {
+    return std::get<i>(metrics);
+  }
+};
+
+namespace detail {
+
+// combine the metrics at the same position of two tuples.
+template <typename... Metrics, typename F, size_t... I>
+MetricsTuple<Metrics...> zipMetrics(
+    const MetricsTuple<Metrics...>& v1,
+    const MetricsTuple<Metrics...>& v2,
+    F f,
+    std::index_sequence<I...>) {
+  return MetricsTuple<Metrics...>(
+      Metrics(f(std::get<I>(v1.metrics), std::get<I>(v2.metrics)))...);
+}
+
+// collect the i-th metric of each value.
+template <size_t i, typename T>
+auto getMetric(const std::vector<T>& src) {
+  std::vector<std::tuple_element_t<i, decltype(T::metrics)>> rst;
+  rst.reserve(src.size());
+  for (auto& item : src) {
+    rst.push_back(std::get<i>(item.metrics));
+  }
+  return rst;
+}
+
+} // namespace detail
+
+template <typename... Metrics>
+MetricsTuple<Metrics...> operator+(
+    const MetricsTuple<Metrics...>& v1,
+    const MetricsTuple<Metrics...>& v2) {
+  return detail::zipMetrics(
+      v1,
+      v2,
+      [](const auto& a, const auto& b) { return a + b; },
+      std::index_sequence_for<Metrics...>());
+}
+
+template <typename... Metrics>
+MetricsTuple<Metrics...> operator-(
+    const MetricsTuple<Metrics...>& v1,
+    const MetricsTuple<Metrics...>& v2) {
+  return detail::zipMetrics(
+      v1,
+      v2,
+      [](const auto& a, const auto& b) { return a - b; },
+      std::index_sequence_for<Metrics...>());
+}
+
+template <typename... Metrics>
+MetricsTuple<Metrics...> operator-(const MetricsTuple<Metrics...>& v) {
+  return detail::zipMetrics(
+      v,
+      v,
+      [](const auto& a, const auto&) { return -a; },
+      std::index_sequence_for<Metrics...>());
+}
+
+template <typename... Metrics>
+void operator+=(
+    MetricsTuple<Metrics...>& v1,
+    const MetricsTuple<Metrics...>& v2) {
+  v1 = v1 + v2;
+}
+
+template <typename... Metrics>
+bool operator==(
+    const MetricsTuple<Metrics...>& v1,
+    const MetricsTuple<Metrics...>& v2) {
+  return v1.metrics == v2.metrics;
+}
+
+template <typename... Metrics>
+class Adapters<MetricsTuple<Metrics...>> {
+  using Indexes = std::index_sequence_for<Metrics...>;
+  static const size_t kMetricCount = sizeof...(Metrics);
+
+ public:
+  static MetricsTuple<Metrics...> convertFromBits(
+      const std::vector<bool>& bits) {
+    return convertFromBits(bits, getOffsets(), Indexes());
+  }
+
+  static std::vector<bool> convertToBits(const MetricsTuple<Metrics...>& src) {
+    std::vector<bool> rst;
+    std::apply(
+        [&rst](const auto&... metric) {
+          (appendBits(rst, Adapters<Metrics>::convertToBits(metric)), ...);
+        },
+        src.metrics);
+    return rst;
+  }
+
+  // every metric is generated from its own fixed-key AES hash of the key, so
+  // the masks of different metrics are independent.
+  static MetricsTuple<Metrics...> generateFromKey(__m128i key) {
+    static const engine::util::Aes hasher(engine::util::Aes::getFixedKey());
+    std::vector<__m128i> keys(kMetricCount);
+    for (size_t i = 0; i < kMetricCount; i++) {
+      keys[i] = _mm_xor_si128(key, _mm_set_epi64x(0, i));
+    }
+    hasher.inPlaceHash(keys);
+    return generateFromKeys(keys, Indexes());
+  }
+
+  // the position of the first bit of each metric in convertToBits(), followed
+  // by the total number of bits.
+  static std::array<size_t, kMetricCount + 1> getOffsets() {
+    std::array<size_t, kMetricCount + 1> rst{};
+    size_t i = 0;
+    ((rst[i + 1] =
+          rst[i] + Adapters<Metrics>::convertToBits(Metrics(0)).size(),
+      i++),
+     ...);
+    return rst;
+  }
+
+ private:
+  static void appendBits(std::vector<bool>& dst, const std::vector<bool>& src) {
+    dst.insert(dst.end(), src.begin(), src.end());
+  }
+
+  template <size_t... I>
+  static MetricsTuple<Metrics...> convertFromBits(
+      const std::vector<bool>& bits,
+      const std::array<size_t, kMetricCount + 1>& offsets,
+      std::index_sequence<I...>) {
+    if (bits.size() != offsets.back()) {
+      throw std::invalid_argument("unexpected input size");
+    }
+    return MetricsTuple<Metrics...>(
+        Adapters<Metrics>::convertFromBits(std::vector<bool>(
+            bits.begin() + offsets.at(I),
+            bits.begin() + offsets.at(I + 1)))...);
+  }
+
+  template <size_t... I>
+  static MetricsTuple<Metrics...> generateFromKeys(
+      const std::vector<__m128i>& keys,
+      std::index_sequence<I...>) {
+    return MetricsTuple<Metrics...>(
+        Adapters<Metrics>::generateFromKey(keys.at(I))...);
+  }
+};
+
+// hashes the keys of a chunk of values together and converts each metric of the
+// chunk with the BulkAdapters of its type.
+template <typename... Metrics>
+class BulkAdapters<MetricsTuple<Metrics...>> {
+  using Indexes = std::index_sequence_for<Metrics...>;
+  static const size_t kMetricCount = sizeof...(Metrics);
+  // the number of values converted at a time.
+  static const size_t kChunkSize = 256;
+
+ public:
+  static void generateFromKeys(
+      const __m128i* keys,
+      size_t size,
+      MetricsTuple<Metrics...>* dst) {
+    for (size_t start = 0; start < size; start += kChunkSize) {
+      auto chunkSize = std::min(kChunkSize, size - start);
+      generateChunk(keys + start, chunkSize, dst + start, Indexes());
+    }
+  }
+
+  static MetricsTuple<Metrics...> addMasksFromKeys(
+      const __m128i* keys,
+      size_t size,
+      MetricsTuple<Metrics...>* dst) {
+    MetricsTuple<Metrics...> sum(0);
+    std::vector<MetricsTuple<Metrics...>> masks(std::min(kChunkSize, size));
+    for (size_t start = 0; start < size; start += kChunkSize) {
+      auto chunkSize = std::min(kChunkSize, size - start);
+      generateChunk(keys + start, chunkSize, masks.data(), Indexes());
+      for (size_t i = 0; i < chunkSize; i++) {
+        dst[start + i] += masks.at(i);
+        sum += masks.at(i);
+      }
+    }
+    return sum;
+  }
+
+ private:
+  template <size_t... I>
+  static void generateChunk(
+      const __m128i* keys,
+      size_t size,
+      MetricsTuple<Metrics...>* dst,
+      std::index_sequence<I...>) {
+    static const engine::util::Aes hasher(engine::util::Aes::getFixedKey());
+    // the same tweaks as Adapters::generateFromKey, laid out metric by metric.
+    std::vector<__m128i> metricKeys(kMetricCount * size);
+    for (size_t i = 0; i < kMetricCount; i++) {
+      auto tweak = _mm_set_epi64x(0, i);
+      for (size_t j = 0; j < size; j++) {
+        metricKeys[i * size + j] = _mm_xor_si128(keys[j], tweak);
+      }
+    }
+    hasher.inPlaceHash(metricKeys);
+    (generateMetric<I>(metricKeys.data() + I * size, size, dst), ...);
+  }
+
+  template <size_t i>
+  static void generateMetric(
+      const __m128i* keys,
+      size_t size,
+      MetricsTuple<Metrics...>* dst) {
+    using Metric = std::tuple_element_t<i, std::tuple<Metrics...>>;
+    std::vector<Metric> metrics(size);
+    BulkAdapters<Metric>::generateFromKeys(keys, size, metrics.data());
+    for (size_t j = 0; j < size; j++) {
+      std::get<i>(dst[j].metrics) = metrics.at(j);
+    }
+  }
+};
+
+template <int schedulerId, typename... Metrics>
+struct SecretMetricsTuple {
+  using Tuple =
+      std::tuple<typename SecBatchType<Metrics, schedulerId>::type...>;
+
+  Tuple metrics;
+};
+
+template <int schedulerId, typename... Metrics>
+SecretMetricsTuple<schedulerId, Metrics...> operator-(
+    const SecretMetricsTuple<schedulerId, Metrics...>& v1,
+    const SecretMetricsTuple<schedulerId, Metrics...>& v2) {
+  return std::apply(
+      [&v2](const auto&... minuends) {
+        return std::apply(
+            [&minuends...](const auto&... subtrahends) {
+              return SecretMetricsTuple<schedulerId, Metrics...>{
+                  {(minuends - subtrahends)...}};
+            },
+            v2.metrics);
+      },
+      v1.metrics);
+}
+
+template <int schedulerId, typename... Metrics>
+struct SecBatchType<MetricsTuple<Metrics...>, schedulerId> {
+  using type = SecretMetricsTuple<schedulerId, Metrics...>;
+};
+
+// Each metric runs its own MPC operations. They are listed in braced
+// initializers, which are evaluated in order, so that both parties run them in
+// the same order.
+template <int schedulerId, typename... Metrics>
+class MpcAdapters<MetricsTuple<Metrics...>, schedulerId> {
+  using Indexes = std::index_sequence_for<Metrics...>;
+
+ public:
+  using SecBatchType = SecretMetricsTuple<schedulerId, Metrics...>;
+
+  static SecBatchType processSecretInputs(
+      const std::vector<MetricsTuple<Metrics...>>& secrets,
+      int secretOwnerPartyId) {
+    return processSecretInputs(secrets, secretOwnerPartyId, Indexes());
+  }
+
+  static SecBatchType recoverBatchSharedSecrets(
+      const std::vector<std::vector<bool>>& src) {
+    auto offsets = Adapters<MetricsTuple<Metrics...>>::getOffsets();
+    if (src.size() != offsets.back()) {
+      throw std::invalid_argument("unexpected input size");
+    }
+    return recoverBatchSharedSecrets(src, offsets, Indexes());
+  }
+
+  static std::pair<SecBatchType, SecBatchType> obliviousSwap(
+      const SecBatchType& src1,
+      const SecBatchType& src2,
+      frontend::Bit<true, schedulerId, true> indicator) {
+    return obliviousSwap(src1, src2, indicator, Indexes());
+  }
+
+  static SecBatchType batchingWith(
+      const SecBatchType& src,
+      const std::vector<SecBatchType>& others) {
+    return batchingWith(src, others, Indexes());
+  }
+
+  static std::vector<MetricsTuple<Metrics...>> openToParty(
+      const SecBatchType& src,
+      int partyId) {
+    return openToParty(src, partyId, Indexes());
+  }
+
+ private:
+  template <size_t... I>
+  static SecBatchType processSecretInputs(
+      const std::vector<MetricsTuple<Metrics...>>& secrets,
+      int secretOwnerPartyId,
+      std::index_sequence<I...>) {
+    return SecBatchType{typename SecBatchType::Tuple{
+        MpcAdapters<Metrics, schedulerId>::processSecretInputs(
+            detail::getMetric<I>(secrets), secretOwnerPartyId)...}};
+  }
+
+  template <size_t... I>
+  static SecBatchType recoverBatchSharedSecrets(
+      const std::vector<std::vector<bool>>& src,
+      const std::array<size_t, sizeof...(Metrics) + 1>& offsets,
+      std::index_sequence<I...>) {
+    return SecBatchType{typename SecBatchType::Tuple{
+        MpcAdapters<Metrics, schedulerId>::recoverBatchSharedSecrets(
+            std::vector<std::vector<bool>>(
+                src.begin() + offsets.at(I),
+                src.begin() + offsets.at(I + 1)))...}};
+  }
+
+  template <size_t... I>
+  static std::pair<SecBatchType, SecBatchType> obliviousSwap(
+      const SecBatchType& src1,
+      const SecBatchType& src2,
+      const frontend::Bit<true, schedulerId, true>& indicator,
+      std::index_sequence<I...>) {
+    std::tuple<
+        std::pair<typename MpcAdapters<Metrics, schedulerId>::SecBatchType,
+                  typename MpcAdapters<Metrics, schedulerId>::SecBatchType>...>
+        swapped{MpcAdapters<Metrics, schedulerId>::obliviousSwap(
+            std::get<I>(src1.metrics),
+            std::get<I>(src2.metrics),
+            indicator)...};
+    return {
+        SecBatchType{{std::get<I>(swapped).first...}},
+        SecBatchType{{std::get<I>(swapped).second...}}};
+  }
+
+  template <size_t... I>
+  static SecBatchType batchingWith(
+      const SecBatchType& src,
+      const std::vector<SecBatchType>& others,
+      std::index_sequence<I...>) {
+    return SecBatchType{typename SecBatchType::Tuple{
+        MpcAdapters<Metrics, schedulerId>::batchingWith(
+            std::get<I>(src.metrics), detail::getMetric<I>(others))...}};
+  }
+
+  template <size_t... I>
+  static std::vector<MetricsTuple<Metrics...>> openToParty(
+      const SecBatchType& src,
+      int partyId,
+      std::index_sequence<I...>) {
+    std::tuple<std::vector<Metrics>...> opened{
+        MpcAdapters<Metrics, schedulerId>::openToParty(
+            std::get<I>(src.metrics), partyId)...};
+
+    auto size = std::get<0>(opened).size();
+    if (((std::get<I>(opened).size() != size) || ...)) {
+      throw std::runtime_error("Unexpected size.");
+    }
+    std::vector<MetricsTuple<Metrics...>> rst;
+    rst.reserve(size);
+    for (size_t i = 0; i < size; i++) {
+      rst.emplace_back(std::get<I>(opened).at(i)...);
+    }
+    return rst;
+  }
+};
+
+} // namespace fbpcf::mpc_std_lib::util
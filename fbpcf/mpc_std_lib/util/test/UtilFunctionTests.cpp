@@ -13,9 +13,13 @@
 #include <functional>
 #include <future>
 #include <iterator>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <random>
+#include <stdexcept>
 
+#include "fbpcf/engine/util/AesPrg.h"
 #include "fbpcf/engine/util/util.h"
 #include "fbpcf/mpc_std_lib/util/test/util.h"
 #include "fbpcf/mpc_std_lib/util/util.h"
@@ -40,6 +44,92 @@ TEST(ConvertingBitsTest, testConvertingBits) {
   testConvertingBits<AggregationValue>();
 }
 
+TEST(MetricsTupleTest, testMetricsTuple) {
+  std::random_device rd;
+  std::mt19937_64 e(rd());
+  for (size_t i = 0; i < 100; i++) {
+    auto [v, _1, _2] = getRandomData<TestMetricsTuple>(e);
+    EXPECT_EQ(
+        Adapters<TestMetricsTuple>::convertFromBits(
+            Adapters<TestMetricsTuple>::convertToBits(v)),
+        v);
+    EXPECT_EQ(v - v, TestMetricsTuple(0));
+    EXPECT_EQ(v + (-v), TestMetricsTuple(0));
+  }
+  EXPECT_EQ(
+      Adapters<TestMetricsTuple>::convertToBits(TestMetricsTuple(0)).size(),
+      32 * 4 + 9);
+
+  auto key = engine::util::getRandomM128iFromSystemNoise();
+  auto mask = Adapters<TestMetricsTuple>::generateFromKey(key);
+  EXPECT_EQ(mask, Adapters<TestMetricsTuple>::generateFromKey(key));
+  // each metric has its own mask.
+  EXPECT_NE(mask.get<0>(), mask.get<2>());
+  EXPECT_NE(mask.get<2>(), mask.get<3>());
+}
+
+template <typename T>
+void testBulkAdapters() {
+  std::random_device rd;
+  std::mt19937_64 e(rd());
+  for (size_t size : {0, 1, 3, 4, 5, 17, 300, 1001}) {
+    std::vector<__m128i> keys(size);
+    std::vector<T> memory(size);
+    for (size_t i = 0; i < size; i++) {
+      keys[i] = engine::util::getRandomM128iFromSystemNoise();
+      memory[i] = std::get<0>(getRandomData<T>(e));
+    }
+    std::vector<T> expectedMasks(size);
+    auto expectedMemory = memory;
+    T expectedSum(0);
+    for (size_t i = 0; i < size; i++) {
+      expectedMasks[i] = Adapters<T>::generateFromKey(keys.at(i));
+      expectedMemory[i] = expectedMemory.at(i) + expectedMasks.at(i);
+      expectedSum = expectedSum + expectedMasks.at(i);
+    }
+
+    std::vector<T> masks(size);
+    BulkAdapters<T>::generateFromKeys(keys.data(), size, masks.data());
+    auto sum =
+        BulkAdapters<T>::addMasksFromKeys(keys.data(), size, memory.data());
+    EXPECT_EQ(sum, expectedSum);
+    for (size_t i = 0; i < size; i++) {
+      EXPECT_EQ(masks.at(i), expectedMasks.at(i));
+      EXPECT_EQ(memory.at(i), expectedMemory.at(i));
+    }
+  }
+}
+
+TEST(BulkAdaptersTest, testBulkAdapters) {
+  testBulkAdapters<uint32_t>();
+  testBulkAdapters<TestIntp>();
+  testBulkAdapters<AggregationValue>();
+  testBulkAdapters<TestMetricsTuple>();
+}
+
+TEST(RandomPermutationTest, testGenerateRandomPermutation) {
+  engine::util::AesPrg prg(engine::util::getRandomM128iFromSystemNoise(), 1024);
+  for (size_t size : {0, 1, 2, 1000, 100000}) {
+    auto permutation = generateRandomPermutation(prg, size);
+    ASSERT_EQ(permutation.size(), size);
+    std::sort(permutation.begin(), permutation.end());
+    for (size_t i = 0; i < size; i++) {
+      EXPECT_EQ(permutation.at(i), i);
+    }
+  }
+
+  // all 6 permutations of 3 elements are about equally likely.
+  std::map<std::vector<uint32_t>, size_t> counts;
+  size_t repeat = 60000;
+  for (size_t i = 0; i < repeat; i++) {
+    counts[generateRandomPermutation(prg, 3)]++;
+  }
+  EXPECT_EQ(counts.size(), 6);
+  for (auto& [_, count] : counts) {
+    EXPECT_NEAR(count, repeat / 6, repeat / 60);
+  }
+}
+
 TEST(ConvertingBitsTest, testConvertingBitsForM128iVector) {
   std::vector<__m128i> v(10000);
   for (auto& item : v) {
@@ -50,4 +140,42 @@ TEST(ConvertingBitsTest, testConvertingBitsForM128iVector) {
   testEq(v, convertedV);
 }
 
+TEST(ParallelForTest, testParallelFor) {
+  for (size_t threadCount : {1, 3, 8}) {
+    for (size_t alignment : {1, 64}) {
+      std::vector<size_t> visited(1000, 0);
+      std::mutex mutex;
+      std::vector<std::pair<size_t, size_t>> ranges;
+      parallelFor(
+          visited.size(),
+          threadCount,
+          [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+              visited[i]++;
+            }
+            std::lock_guard<std::mutex> lock(mutex);
+            ranges.emplace_back(begin, end);
+          },
+          alignment);
+      EXPECT_LE(ranges.size(), threadCount);
+      for (auto& [begin, _] : ranges) {
+        EXPECT_EQ(begin % alignment, 0);
+      }
+      for (auto v : visited) {
+        EXPECT_EQ(v, 1);
+      }
+    }
+  }
+  EXPECT_THROW(
+      parallelFor(
+          100,
+          4,
+          [](size_t begin, size_t) {
+            if (begin > 0) {
+              throw std::runtime_error("failed");
+            }
+          }),
+      std::runtime_error);
+}
+
 } // namespace fbpcf::mpc_std_lib::util
@@ -58,6 +58,38 @@ inline std::tuple<TestIntp, TestIntp, TestIntp> getRandomData<TestIntp>(
   return {value, share0, share1};
 }
 
+template <typename... Metrics>
+std::tuple<
+    MetricsTuple<Metrics...>,
+    MetricsTuple<Metrics...>,
+    MetricsTuple<Metrics...>>
+getRandomMetricsTuple(std::mt19937_64& e) {
+  std::tuple<std::tuple<Metrics, Metrics, Metrics>...> data{
+      getRandomData<Metrics>(e)...};
+  return std::apply(
+      [](const auto&... item) {
+        return std::make_tuple(
+            MetricsTuple<Metrics...>(std::get<0>(item)...),
+            MetricsTuple<Metrics...>(std::get<1>(item)...),
+            MetricsTuple<Metrics...>(std::get<2>(item)...));
+      },
+      data);
+}
+
+using TestMetricsTuple =
+    MetricsTuple<uint32_t, TestIntp, uint32_t, uint32_t, uint32_t>;
+
+template <>
+inline std::tuple<TestMetricsTuple, TestMetricsTuple, TestMetricsTuple>
+getRandomData<TestMetricsTuple>(std::mt19937_64& e) {
+  return getRandomMetricsTuple<
+      uint32_t,
+      TestIntp,
+      uint32_t,
+      uint32_t,
+      uint32_t>(e);
+}
+
 template <>
 inline std::tuple<AggregationValue, AggregationValue, AggregationValue>
 getRandomData<AggregationValue>(std::mt19937_64& e) {
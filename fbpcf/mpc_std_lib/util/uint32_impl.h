@@ -48,6 +48,56 @@ class Adapters<uint32_t> {
   }
 };
 
+// converts four keys at a time, taking the lowest 32 bits of each key.
+template <>
+class BulkAdapters<uint32_t> {
+ public:
+  static void generateFromKeys(
+      const __m128i* keys,
+      size_t size,
+      uint32_t* dst) {
+    size_t i = 0;
+    for (; i + 4 <= size; i += 4) {
+      _mm_storeu_si128(
+          reinterpret_cast<__m128i*>(dst + i), getLowestLanes(keys + i));
+    }
+    for (; i < size; i++) {
+      dst[i] = Adapters<uint32_t>::generateFromKey(keys[i]);
+    }
+  }
+
+  static uint32_t addMasksFromKeys(
+      const __m128i* keys,
+      size_t size,
+      uint32_t* dst) {
+    auto sum = _mm_setzero_si128();
+    size_t i = 0;
+    for (; i + 4 <= size; i += 4) {
+      auto masks = getLowestLanes(keys + i);
+      auto memory = reinterpret_cast<__m128i*>(dst + i);
+      _mm_storeu_si128(memory, _mm_add_epi32(_mm_loadu_si128(memory), masks));
+      sum = _mm_add_epi32(sum, masks);
+    }
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+    uint32_t rst = _mm_cvtsi128_si32(sum);
+    for (; i < size; i++) {
+      auto mask = Adapters<uint32_t>::generateFromKey(keys[i]);
+      dst[i] += mask;
+      rst += mask;
+    }
+    return rst;
+  }
+
+ private:
+  // the lowest 32 bits of keys[0], ..., keys[3].
+  static __m128i getLowestLanes(const __m128i* keys) {
+    auto lanes01 = _mm_unpacklo_epi32(keys[0], keys[1]);
+    auto lanes23 = _mm_unpacklo_epi32(keys[2], keys[3]);
+    return _mm_unpacklo_epi64(lanes01, lanes23);
+  }
+};
+
 template <int schedulerId>
 struct SecBatchType<uint32_t, schedulerId> {
   using type = frontend::
@@ -72,6 +122,12 @@ class MpcAdapters<uint32_t, schedulerId> {
       const SecBatchType& src2,
       frontend::Bit<true, schedulerId, true> indicator);
 
+  static SecBatchType batchingWith(
+      const SecBatchType& src,
+      const std::vector<SecBatchType>& others) {
+    return src.batchingWith(others);
+  }
+
   static std::vector<uint32_t> openToParty(
       const SecBatchType& src,
       int partyId) {
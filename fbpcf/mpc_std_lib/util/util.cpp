@@ -7,6 +7,11 @@
 
 #include "fbpcf/mpc_std_lib/util/util.h"
 #include <smmintrin.h>
+#include <algorithm>
+#include <cstring>
+#include <future>
+#include <limits>
+#include <numeric>
 #include <stdexcept>
 
 namespace fbpcf::mpc_std_lib::util {
@@ -63,4 +68,69 @@ std::vector<__m128i> convertFromBits(
   return rst;
 }
 
+std::vector<uint32_t> generateRandomPermutation(
+    engine::util::IPrg& prg,
+    size_t size) {
+  if (size > std::numeric_limits<uint32_t>::max()) {
+    throw std::invalid_argument("Too many elements to permute.");
+  }
+  std::vector<uint32_t> rst(size);
+  std::iota(rst.begin(), rst.end(), 0);
+
+  // the random numbers not used yet, refilled one chunk at a time.
+  const size_t kChunkSize = 1 << 16;
+  std::vector<uint32_t> randomNumbers;
+  size_t next = 0;
+  auto getRandomNumber = [&]() {
+    if (next == randomNumbers.size()) {
+      auto count = std::min(kChunkSize, size);
+      auto bytes = prg.getRandomBytes(count * sizeof(uint32_t));
+      randomNumbers.resize(count);
+      std::memcpy(randomNumbers.data(), bytes.data(), bytes.size());
+      next = 0;
+    }
+    return randomNumbers[next++];
+  };
+
+  for (size_t i = size; i > 1; i--) {
+    uint32_t bound = i;
+    uint64_t product = uint64_t(getRandomNumber()) * bound;
+    uint32_t low = product;
+    if (low < bound) {
+      // reject the products that would make some positions more likely.
+      uint32_t threshold = -bound % bound;
+      while (low < threshold) {
+        product = uint64_t(getRandomNumber()) * bound;
+        low = product;
+      }
+    }
+    std::swap(rst[product >> 32], rst[i - 1]);
+  }
+  return rst;
+}
+
+void parallelFor(
+    size_t size,
+    size_t threadCount,
+    const std::function<void(size_t begin, size_t end)>& f,
+    size_t alignment) {
+  alignment = std::max<size_t>(alignment, 1);
+  auto rangeSize = (size + threadCount - 1) / std::max<size_t>(threadCount, 1);
+  rangeSize = (rangeSize + alignment - 1) / alignment * alignment;
+  if (threadCount <= 1 || rangeSize >= size) {
+    f(0, size);
+    return;
+  }
+  std::vector<std::future<void>> futures;
+  // the calling thread takes the first range.
+  for (size_t begin = rangeSize; begin < size; begin += rangeSize) {
+    futures.push_back(std::async(
+        std::launch::async, f, begin, std::min(begin + rangeSize, size)));
+  }
+  f(0, rangeSize);
+  for (auto& future : futures) {
+    future.get();
+  }
+}
+
 } // namespace fbpcf::mpc_std_lib::util
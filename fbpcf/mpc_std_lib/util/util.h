@@ -9,8 +9,10 @@
 
 #include <emmintrin.h>
 
+#include <functional>
 #include <vector>
 #include "fbpcf/frontend/Bit.h"
+#include "fbpcf/engine/util/IPrg.h"
 #include "fbpcf/frontend/Int.h"
 
 namespace fbpcf::mpc_std_lib::util {
@@ -33,6 +35,34 @@ class Adapters {
   static T generateFromKey(__m128i key);
 };
 
+/*
+ * bulk versions of Adapters<T>::generateFromKey, e.g. to convert all the leaves
+ * of a single point array. The default implementations convert one key at a
+ * time; specializations can convert several keys at once with SIMD.
+ */
+template <typename T>
+class BulkAdapters {
+ public:
+  // dst[i] = generateFromKey(keys[i]) for all i < size.
+  static void generateFromKeys(const __m128i* keys, size_t size, T* dst) {
+    for (size_t i = 0; i < size; i++) {
+      dst[i] = Adapters<T>::generateFromKey(keys[i]);
+    }
+  }
+
+  // add generateFromKey(keys[i]) to dst[i] for all i < size, without
+  // materializing the masks, and return the sum of the masks.
+  static T addMasksFromKeys(const __m128i* keys, size_t size, T* dst) {
+    T sum(0);
+    for (size_t i = 0; i < size; i++) {
+      auto mask = Adapters<T>::generateFromKey(keys[i]);
+      dst[i] = dst[i] + mask;
+      sum = sum + mask;
+    }
+    return sum;
+  }
+};
+
 // these helpers are for MPC part
 
 template <typename T, int schedulerId>
@@ -54,6 +84,11 @@ class MpcAdapters {
       const SecBatchType& src2,
       frontend::Bit<true, schedulerId, true> indicator);
 
+  // concatenate batches, e.g. to open them together in one round.
+  static SecBatchType batchingWith(
+      const SecBatchType& src,
+      const std::vector<SecBatchType>& others);
+
   static std::vector<T> openToParty(const SecBatchType& src, int partyId);
 };
 
@@ -61,11 +96,34 @@ std::vector<std::vector<bool>> convertToBits(const std::vector<__m128i>& src);
 
 std::vector<__m128i> convertFromBits(const std::vector<std::vector<bool>>& src);
 
+/**
+ * Generate a uniformly random permutation of [0, size) with the Fisher-Yates
+ * shuffle. The random numbers are drawn from prg in large chunks and reduced to
+ * each range without bias with Lemire's multiply-and-reject method.
+ */
+std::vector<uint32_t> generateRandomPermutation(
+    engine::util::IPrg& prg,
+    size_t size);
+
+/**
+ * Split [0, size) into up to threadCount consecutive ranges and run
+ * f(begin, end) on each of them in parallel. The ranges start at multiples of
+ * alignment, e.g. 64 keeps threads that write to different ranges of a
+ * std::vector<bool> from sharing a word. Exceptions thrown by f are rethrown
+ * here.
+ */
+void parallelFor(
+    size_t size,
+    size_t threadCount,
+    const std::function<void(size_t begin, size_t end)>& f,
+    size_t alignment = 1);
+
 } // namespace fbpcf::mpc_std_lib::util
 
 #include "fbpcf/mpc_std_lib/util/uint32_impl.h"
 
 #include "fbpcf/mpc_std_lib/util/Intp_impl.h"
 #include "fbpcf/mpc_std_lib/util/aggregationValue_impl.h"
+#include "fbpcf/mpc_std_lib/util/metricsTuple_impl.h"
 
 #include "fbpcf/mpc_std_lib/util/bitstring_impl.h"
@@ -79,7 +79,7 @@ EagerScheduler::openBooleanValueToPartyBatch(
   auto revealedSecrets = engine_->revealToParty(partyId, secretShares);
 
   if (revealedSecrets.size() == secretShares.size()) {
-    return wireKeeper_->allocateBatchBooleanValue(revealedSecrets);
+    return wireKeeper_->allocateBatchBooleanValue(std::move(revealedSecrets));
   } else {
     throw std::runtime_error(
         "Unexpected number of revealed secrets " +
@@ -200,7 +200,8 @@ EagerScheduler::privateAndPrivateCompositeBatch(
   std::vector<IScheduler::WireId<IScheduler::Boolean>> outputWires(
       result.size());
   for (size_t i = 0; i < result.size(); i++) {
-    outputWires[i] = wireKeeper_->allocateBatchBooleanValue(result[i]);
+    outputWires[i] =
+        wireKeeper_->allocateBatchBooleanValue(std::move(result[i]));
   }
   return outputWires;
 }
@@ -355,39 +356,33 @@ void EagerScheduler::decreaseReferenceCountBatch(
 // band a number of batches into one batch.
 IScheduler::WireId<IScheduler::Boolean> EagerScheduler::batchingUp(
     std::vector<WireId<Boolean>> src) {
-  size_t batchSize = 0;
-  for (auto& item : src) {
-    batchSize += wireKeeper_->getBatchBooleanValue(item).size();
-  }
-  std::vector<bool> vector(batchSize, 0);
-  size_t index = 0;
-  for (auto& item : src) {
-    auto& batch = wireKeeper_->getBatchBooleanValue(item);
-    for (size_t i = 0; i < batch.size(); i++) {
-      vector[index++] = batch.at(i);
-    }
+  std::vector<IWireKeeper::BatchSlice> slices(src.size());
+  for (size_t i = 0; i < src.size(); i++) {
+    slices[i] = IWireKeeper::BatchSlice{
+        src.at(i), 0, wireKeeper_->getBatchBooleanSize(src.at(i))};
   }
-  return wireKeeper_->allocateBatchBooleanValue(vector);
+  auto rst = wireKeeper_->allocateBatchBooleanValue(std::vector<bool>());
+  wireKeeper_->setBatchBooleanView(rst, slices);
+  return rst;
 }
 
 // decompose a batch of values into several smaller batches.
 std::vector<IScheduler::WireId<IScheduler::Boolean>> EagerScheduler::unbatching(
     WireId<Boolean> src,
     std::shared_ptr<std::vector<uint32_t>> unbatchingStrategy) {
-  auto& batch = wireKeeper_->getBatchBooleanValue(src);
+  auto batchSize = wireKeeper_->getBatchBooleanSize(src);
   size_t index = 0;
   std::vector<IScheduler::WireId<IScheduler::Boolean>> rst(
       unbatchingStrategy->size());
   for (size_t i = 0; i < rst.size(); i++) {
-    std::vector<bool> v(unbatchingStrategy->at(i));
-    if (index + v.size() > batch.size()) {
+    size_t size = unbatchingStrategy->at(i);
+    if (index + size > batchSize) {
       throw std::runtime_error(
           "Failed to unbatch, you are unbatching to more values than the input has.");
     }
-    for (size_t j = 0; j < v.size(); j++) {
-      v[j] = batch.at(index++);
-    }
-    rst[i] = wireKeeper_->allocateBatchBooleanValue(v);
+    rst[i] = wireKeeper_->allocateBatchBooleanValue(std::vector<bool>());
+    wireKeeper_->setBatchBooleanView(rst[i], {{src, index, size}});
+    index += size;
   }
   return rst;
 }
@@ -7,8 +7,10 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <vector>
 
 #include "fbpcf/scheduler/IScheduler.h"
 
@@ -90,6 +92,11 @@ class IWireKeeper {
       const std::vector<bool>& v,
       uint32_t firstAvailableLevel = 0) = 0;
 
+  // same as above, but takes ownership of the storage of v.
+  virtual IScheduler::WireId<IScheduler::Boolean> allocateBatchBooleanValue(
+      std::vector<bool>&& v,
+      uint32_t firstAvailableLevel = 0) = 0;
+
   // create an integer wire with values v, return its wire id.
   virtual IScheduler::WireId<IScheduler::Arithmetic> allocateBatchIntegerValue(
       const std::vector<uint64_t>& v,
@@ -121,6 +128,27 @@ class IWireKeeper {
       IScheduler::WireId<IScheduler::Arithmetic> id,
       const std::vector<uint64_t>& v) = 0;
 
+  // A range of the values of a boolean batch wire.
+  struct BatchSlice {
+    IScheduler::WireId<IScheduler::Boolean> src;
+    size_t offset;
+    size_t length;
+  };
+
+  // get the number of values of the boolean batch wire with given id without
+  // resolving it, if it is a view.
+  virtual size_t getBatchBooleanSize(
+      IScheduler::WireId<IScheduler::Boolean> id) const = 0;
+
+  // turn the boolean batch wire with given id into a view of the
+  // concatenation of the given slices. No values are copied here: the view
+  // holds a reference to its source wires until it is overwritten or freed,
+  // and is only resolved (i.e. copied) when its value is read by a gate, or on
+  // write. Views of views are resolved directly from the underlying wires.
+  virtual void setBatchBooleanView(
+      IScheduler::WireId<IScheduler::Boolean> id,
+      const std::vector<BatchSlice>& slices) = 0;
+
   // get the level when the wire with the given ID will have its value set.
   virtual uint32_t getBatchFirstAvailableLevel(
       IScheduler::WireId<IScheduler::Boolean> id) const = 0;
@@ -172,6 +200,20 @@ class IWireKeeper {
     uint32_t firstAvailableLevel;
     uint32_t referenceCount;
   };
+
+  // The record of a boolean batch wire. A wire that setBatchBooleanView()
+  // turned into a view keeps its slices here, and v holds no values until the
+  // view is resolved. Plain wires leave viewSlices empty.
+  struct BatchBooleanWireRecord {
+    // a view is resolved by the const getters the first time it is read, so v
+    // and viewResolved cache its values and are mutable.
+    mutable std::vector<bool> v;
+    uint32_t firstAvailableLevel = 0;
+    uint32_t referenceCount = 0;
+    std::vector<BatchSlice> viewSlices = {};
+    size_t viewSize = 0;
+    mutable bool viewResolved = true;
+  };
 };
 
 } // namespace fbpcf::scheduler
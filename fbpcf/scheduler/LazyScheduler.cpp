@@ -19,23 +19,26 @@
 
 namespace fbpcf::scheduler {
 
-LazyScheduler::LazyScheduler(
+template <typename WireKeeperT>
+BasicLazyScheduler<WireKeeperT>::BasicLazyScheduler(
     std::unique_ptr<engine::ISecretShareEngine> engine,
-    std::shared_ptr<IWireKeeper> wireKeeper,
+    std::shared_ptr<WireKeeperT> wireKeeper,
     std::unique_ptr<IGateKeeper> gateKeeper)
     : engine_{std::move(engine)},
       wireKeeper_{std::move(wireKeeper)},
       gateKeeper_{std::move(gateKeeper)} {}
 
-IScheduler::WireId<IScheduler::Boolean> LazyScheduler::privateBooleanInput(
-    bool v,
-    int partyId) {
+template <typename WireKeeperT>
+IScheduler::WireId<IScheduler::Boolean>
+BasicLazyScheduler<WireKeeperT>::privateBooleanInput(bool v, int partyId) {
   auto id = gateKeeper_->inputGate(engine_->setInput(partyId, v));
   maybeExecuteGates();
   return id;
 }
 
-IScheduler::WireId<IScheduler::Boolean> LazyScheduler::privateBooleanInputBatch(
+template <typename WireKeeperT>
+IScheduler::WireId<IScheduler::Boolean>
+BasicLazyScheduler<WireKeeperT>::privateBooleanInputBatch(
     const std::vector<bool>& v,
     int partyId) {
   auto id = gateKeeper_->inputGateBatch(engine_->setBatchInput(partyId, v));
@@ -43,35 +46,43 @@ IScheduler::WireId<IScheduler::Boolean> LazyScheduler::privateBooleanInputBatch(
   return id;
 }
 
-IScheduler::WireId<IScheduler::Boolean> LazyScheduler::publicBooleanInput(
-    bool v) {
+template <typename WireKeeperT>
+IScheduler::WireId<IScheduler::Boolean>
+BasicLazyScheduler<WireKeeperT>::publicBooleanInput(bool v) {
   auto id = gateKeeper_->inputGate(v);
   maybeExecuteGates();
   return id;
 }
 
-IScheduler::WireId<IScheduler::Boolean> LazyScheduler::publicBooleanInputBatch(
+template <typename WireKeeperT>
+IScheduler::WireId<IScheduler::Boolean>
+BasicLazyScheduler<WireKeeperT>::publicBooleanInputBatch(
     const std::vector<bool>& v) {
   auto id = gateKeeper_->inputGateBatch(v);
   maybeExecuteGates();
   return id;
 }
 
-IScheduler::WireId<IScheduler::Boolean> LazyScheduler::recoverBooleanWire(
-    bool v) {
+template <typename WireKeeperT>
+IScheduler::WireId<IScheduler::Boolean>
+BasicLazyScheduler<WireKeeperT>::recoverBooleanWire(bool v) {
   auto id = gateKeeper_->inputGate(v);
   maybeExecuteGates();
   return id;
 }
 
-IScheduler::WireId<IScheduler::Boolean> LazyScheduler::recoverBooleanWireBatch(
+template <typename WireKeeperT>
+IScheduler::WireId<IScheduler::Boolean>
+BasicLazyScheduler<WireKeeperT>::recoverBooleanWireBatch(
     const std::vector<bool>& v) {
   auto id = gateKeeper_->inputGateBatch(v);
   maybeExecuteGates();
   return id;
 }
 
-IScheduler::WireId<IScheduler::Boolean> LazyScheduler::openBooleanValueToParty(
+template <typename WireKeeperT>
+IScheduler::WireId<IScheduler::Boolean>
+BasicLazyScheduler<WireKeeperT>::openBooleanValueToParty(
     WireId<IScheduler::Boolean> src,
     int partyId) {
   auto id = gateKeeper_->outputGate(src, partyId);
@@ -79,8 +90,9 @@ IScheduler::WireId<IScheduler::Boolean> LazyScheduler::openBooleanValueToParty(
   return id;
 }
 
+template <typename WireKeeperT>
 IScheduler::WireId<IScheduler::Boolean>
-LazyScheduler::openBooleanValueToPartyBatch(
+BasicLazyScheduler<WireKeeperT>::openBooleanValueToPartyBatch(
     WireId<IScheduler::Boolean> src,
     int partyId) {
   auto id = gateKeeper_->outputGateBatch(src, partyId);
@@ -88,25 +100,34 @@ LazyScheduler::openBooleanValueToPartyBatch(
   return id;
 }
 
-bool LazyScheduler::extractBooleanSecretShare(WireId<IScheduler::Boolean> id) {
+template <typename WireKeeperT>
+bool BasicLazyScheduler<WireKeeperT>::extractBooleanSecretShare(
+    WireId<IScheduler::Boolean> id) {
   return forceWire<false>(id);
 }
 
-std::vector<bool> LazyScheduler::extractBooleanSecretShareBatch(
+template <typename WireKeeperT>
+std::vector<bool>
+BasicLazyScheduler<WireKeeperT>::extractBooleanSecretShareBatch(
     WireId<IScheduler::Boolean> id) {
   return forceWire<true>(id);
 }
 
-bool LazyScheduler::getBooleanValue(WireId<IScheduler::Boolean> id) {
+template <typename WireKeeperT>
+bool BasicLazyScheduler<WireKeeperT>::getBooleanValue(
+    WireId<IScheduler::Boolean> id) {
   return forceWire<false>(id);
 }
 
-std::vector<bool> LazyScheduler::getBooleanValueBatch(
+template <typename WireKeeperT>
+std::vector<bool> BasicLazyScheduler<WireKeeperT>::getBooleanValueBatch(
     WireId<IScheduler::Boolean> id) {
   return forceWire<true>(id);
 }
 
-IScheduler::WireId<IScheduler::Boolean> LazyScheduler::privateAndPrivate(
+template <typename WireKeeperT>
+IScheduler::WireId<IScheduler::Boolean>
+BasicLazyScheduler<WireKeeperT>::privateAndPrivate(
     WireId<IScheduler::Boolean> left,
     WireId<IScheduler::Boolean> right) {
   auto id = gateKeeper_->normalGate(
@@ -115,7 +136,9 @@ IScheduler::WireId<IScheduler::Boolean> LazyScheduler::privateAndPrivate(
   return id;
 }
 
-IScheduler::WireId<IScheduler::Boolean> LazyScheduler::privateAndPrivateBatch(
+template <typename WireKeeperT>
+IScheduler::WireId<IScheduler::Boolean>
+BasicLazyScheduler<WireKeeperT>::privateAndPrivateBatch(
     WireId<IScheduler::Boolean> left,
     WireId<IScheduler::Boolean> right) {
   auto id = gateKeeper_->normalGateBatch(
@@ -124,7 +147,9 @@ IScheduler::WireId<IScheduler::Boolean> LazyScheduler::privateAndPrivateBatch(
   return id;
 }
 
-IScheduler::WireId<IScheduler::Boolean> LazyScheduler::privateAndPublic(
+template <typename WireKeeperT>
+IScheduler::WireId<IScheduler::Boolean>
+BasicLazyScheduler<WireKeeperT>::privateAndPublic(
     WireId<IScheduler::Boolean> left,
     WireId<IScheduler::Boolean> right) {
   auto id = gateKeeper_->normalGate(
@@ -133,7 +158,9 @@ IScheduler::WireId<IScheduler::Boolean> LazyScheduler::privateAndPublic(
   return id;
 }
 
-IScheduler::WireId<IScheduler::Boolean> LazyScheduler::privateAndPublicBatch(
+template <typename WireKeeperT>
+IScheduler::WireId<IScheduler::Boolean>
+BasicLazyScheduler<WireKeeperT>::privateAndPublicBatch(
     WireId<IScheduler::Boolean> left,
     WireId<IScheduler::Boolean> right) {
   auto id = gateKeeper_->normalGateBatch(
@@ -142,7 +169,9 @@ IScheduler::WireId<IScheduler::Boolean> LazyScheduler::privateAndPublicBatch(
   return id;
 }
 
-IScheduler::WireId<IScheduler::Boolean> LazyScheduler::publicAndPublic(
+template <typename WireKeeperT>
+IScheduler::WireId<IScheduler::Boolean>
+BasicLazyScheduler<WireKeeperT>::publicAndPublic(
     WireId<IScheduler::Boolean> left,
     WireId<IScheduler::Boolean> right) {
   auto id = gateKeeper_->normalGate(
@@ -151,7 +180,9 @@ IScheduler::WireId<IScheduler::Boolean> LazyScheduler::publicAndPublic(
   return id;
 }
 
-IScheduler::WireId<IScheduler::Boolean> LazyScheduler::publicAndPublicBatch(
+template <typename WireKeeperT>
+IScheduler::WireId<IScheduler::Boolean>
+BasicLazyScheduler<WireKeeperT>::publicAndPublicBatch(
     WireId<IScheduler::Boolean> left,
     WireId<IScheduler::Boolean> right) {
   auto id = gateKeeper_->normalGateBatch(
@@ -160,8 +191,9 @@ IScheduler::WireId<IScheduler::Boolean> LazyScheduler::publicAndPublicBatch(
   return id;
 }
 
+template <typename WireKeeperT>
 std::vector<IScheduler::WireId<IScheduler::Boolean>>
-LazyScheduler::privateAndPrivateComposite(
+BasicLazyScheduler<WireKeeperT>::privateAndPrivateComposite(
     IScheduler::WireId<IScheduler::Boolean> left,
     std::vector<IScheduler::WireId<IScheduler::Boolean>> rights) {
   auto id = gateKeeper_->compositeGate(
@@ -170,8 +202,9 @@ LazyScheduler::privateAndPrivateComposite(
   return id;
 }
 
+template <typename WireKeeperT>
 std::vector<IScheduler::WireId<IScheduler::Boolean>>
-LazyScheduler::privateAndPrivateCompositeBatch(
+BasicLazyScheduler<WireKeeperT>::privateAndPrivateCompositeBatch(
     IScheduler::WireId<IScheduler::Boolean> left,
     std::vector<IScheduler::WireId<IScheduler::Boolean>> rights) {
   auto id = gateKeeper_->compositeGateBatch(
@@ -180,8 +213,9 @@ LazyScheduler::privateAndPrivateCompositeBatch(
   return id;
 }
 
+template <typename WireKeeperT>
 std::vector<IScheduler::WireId<IScheduler::Boolean>>
-LazyScheduler::privateAndPublicComposite(
+BasicLazyScheduler<WireKeeperT>::privateAndPublicComposite(
     IScheduler::WireId<IScheduler::Boolean> left,
     std::vector<IScheduler::WireId<IScheduler::Boolean>> rights) {
   auto id = gateKeeper_->compositeGate(
@@ -190,8 +224,9 @@ LazyScheduler::privateAndPublicComposite(
   return id;
 }
 
+template <typename WireKeeperT>
 std::vector<IScheduler::WireId<IScheduler::Boolean>>
-LazyScheduler::privateAndPublicCompositeBatch(
+BasicLazyScheduler<WireKeeperT>::privateAndPublicCompositeBatch(
     IScheduler::WireId<IScheduler::Boolean> left,
     std::vector<IScheduler::WireId<IScheduler::Boolean>> rights) {
   auto id = gateKeeper_->compositeGateBatch(
@@ -200,8 +235,9 @@ LazyScheduler::privateAndPublicCompositeBatch(
   return id;
 }
 
+template <typename WireKeeperT>
 std::vector<IScheduler::WireId<IScheduler::Boolean>>
-LazyScheduler::publicAndPublicComposite(
+BasicLazyScheduler<WireKeeperT>::publicAndPublicComposite(
     IScheduler::WireId<IScheduler::Boolean> left,
     std::vector<IScheduler::WireId<IScheduler::Boolean>> rights) {
   auto id = gateKeeper_->compositeGate(
@@ -210,8 +246,9 @@ LazyScheduler::publicAndPublicComposite(
   return id;
 }
 
+template <typename WireKeeperT>
 std::vector<IScheduler::WireId<IScheduler::Boolean>>
-LazyScheduler::publicAndPublicCompositeBatch(
+BasicLazyScheduler<WireKeeperT>::publicAndPublicCompositeBatch(
     IScheduler::WireId<IScheduler::Boolean> left,
     std::vector<IScheduler::WireId<IScheduler::Boolean>> rights) {
   auto id = gateKeeper_->compositeGateBatch(
@@ -220,7 +257,9 @@ LazyScheduler::publicAndPublicCompositeBatch(
   return id;
 }
 
-IScheduler::WireId<IScheduler::Boolean> LazyScheduler::privateXorPrivate(
+template <typename WireKeeperT>
+IScheduler::WireId<IScheduler::Boolean>
+BasicLazyScheduler<WireKeeperT>::privateXorPrivate(
     WireId<IScheduler::Boolean> left,
     WireId<IScheduler::Boolean> right) {
   auto id = gateKeeper_->normalGate(
@@ -229,7 +268,9 @@ IScheduler::WireId<IScheduler::Boolean> LazyScheduler::privateXorPrivate(
   return id;
 }
 
-IScheduler::WireId<IScheduler::Boolean> LazyScheduler::privateXorPrivateBatch(
+template <typename WireKeeperT>
+IScheduler::WireId<IScheduler::Boolean>
+BasicLazyScheduler<WireKeeperT>::privateXorPrivateBatch(
     WireId<IScheduler::Boolean> left,
     WireId<IScheduler::Boolean> right) {
   auto id = gateKeeper_->normalGateBatch(
@@ -238,7 +279,9 @@ IScheduler::WireId<IScheduler::Boolean> LazyScheduler::privateXorPrivateBatch(
   return id;
 }
 
-IScheduler::WireId<IScheduler::Boolean> LazyScheduler::privateXorPublic(
+template <typename WireKeeperT>
+IScheduler::WireId<IScheduler::Boolean>
+BasicLazyScheduler<WireKeeperT>::privateXorPublic(
     WireId<IScheduler::Boolean> left,
     WireId<IScheduler::Boolean> right) {
   auto id = gateKeeper_->normalGate(
@@ -247,7 +290,9 @@ IScheduler::WireId<IScheduler::Boolean> LazyScheduler::privateXorPublic(
   return id;
 }
 
-IScheduler::WireId<IScheduler::Boolean> LazyScheduler::privateXorPublicBatch(
+template <typename WireKeeperT>
+IScheduler::WireId<IScheduler::Boolean>
+BasicLazyScheduler<WireKeeperT>::privateXorPublicBatch(
     WireId<IScheduler::Boolean> left,
     WireId<IScheduler::Boolean> right) {
   auto id = gateKeeper_->normalGateBatch(
@@ -256,7 +301,9 @@ IScheduler::WireId<IScheduler::Boolean> LazyScheduler::privateXorPublicBatch(
   return id;
 }
 
-IScheduler::WireId<IScheduler::Boolean> LazyScheduler::publicXorPublic(
+template <typename WireKeeperT>
+IScheduler::WireId<IScheduler::Boolean>
+BasicLazyScheduler<WireKeeperT>::publicXorPublic(
     WireId<IScheduler::Boolean> left,
     WireId<IScheduler::Boolean> right) {
   auto id = gateKeeper_->normalGate(
@@ -265,7 +312,9 @@ IScheduler::WireId<IScheduler::Boolean> LazyScheduler::publicXorPublic(
   return id;
 }
 
-IScheduler::WireId<IScheduler::Boolean> LazyScheduler::publicXorPublicBatch(
+template <typename WireKeeperT>
+IScheduler::WireId<IScheduler::Boolean>
+BasicLazyScheduler<WireKeeperT>::publicXorPublicBatch(
     WireId<IScheduler::Boolean> left,
     WireId<IScheduler::Boolean> right) {
   auto id = gateKeeper_->normalGateBatch(
@@ -274,15 +323,18 @@ IScheduler::WireId<IScheduler::Boolean> LazyScheduler::publicXorPublicBatch(
   return id;
 }
 
-IScheduler::WireId<IScheduler::Boolean> LazyScheduler::notPrivate(
-    WireId<IScheduler::Boolean> src) {
+template <typename WireKeeperT>
+IScheduler::WireId<IScheduler::Boolean>
+BasicLazyScheduler<WireKeeperT>::notPrivate(WireId<IScheduler::Boolean> src) {
   auto id = gateKeeper_->normalGate(
       INormalGate<IScheduler::Boolean>::GateType::AsymmetricNot, src);
   maybeExecuteGates();
   return id;
 }
 
-IScheduler::WireId<IScheduler::Boolean> LazyScheduler::notPrivateBatch(
+template <typename WireKeeperT>
+IScheduler::WireId<IScheduler::Boolean>
+BasicLazyScheduler<WireKeeperT>::notPrivateBatch(
     WireId<IScheduler::Boolean> src) {
   auto id = gateKeeper_->normalGateBatch(
       INormalGate<IScheduler::Boolean>::GateType::AsymmetricNot, src);
@@ -290,15 +342,18 @@ IScheduler::WireId<IScheduler::Boolean> LazyScheduler::notPrivateBatch(
   return id;
 }
 
-IScheduler::WireId<IScheduler::Boolean> LazyScheduler::notPublic(
-    WireId<IScheduler::Boolean> src) {
+template <typename WireKeeperT>
+IScheduler::WireId<IScheduler::Boolean>
+BasicLazyScheduler<WireKeeperT>::notPublic(WireId<IScheduler::Boolean> src) {
   auto id = gateKeeper_->normalGate(
       INormalGate<IScheduler::Boolean>::GateType::SymmetricNot, src);
   maybeExecuteGates();
   return id;
 }
 
-IScheduler::WireId<IScheduler::Boolean> LazyScheduler::notPublicBatch(
+template <typename WireKeeperT>
+IScheduler::WireId<IScheduler::Boolean>
+BasicLazyScheduler<WireKeeperT>::notPublicBatch(
     WireId<IScheduler::Boolean> src) {
   auto id = gateKeeper_->normalGateBatch(
       INormalGate<IScheduler::Boolean>::GateType::SymmetricNot, src);
@@ -306,37 +361,48 @@ IScheduler::WireId<IScheduler::Boolean> LazyScheduler::notPublicBatch(
   return id;
 }
 
-void LazyScheduler::increaseReferenceCount(WireId<IScheduler::Boolean> id) {
+template <typename WireKeeperT>
+void BasicLazyScheduler<WireKeeperT>::increaseReferenceCount(
+    WireId<IScheduler::Boolean> id) {
   wireKeeper_->increaseReferenceCount(id);
 }
 
-void LazyScheduler::increaseReferenceCountBatch(
+template <typename WireKeeperT>
+void BasicLazyScheduler<WireKeeperT>::increaseReferenceCountBatch(
     WireId<IScheduler::Boolean> id) {
   wireKeeper_->increaseBatchReferenceCount(id);
 }
 
-void LazyScheduler::decreaseReferenceCount(WireId<IScheduler::Boolean> id) {
+template <typename WireKeeperT>
+void BasicLazyScheduler<WireKeeperT>::decreaseReferenceCount(
+    WireId<IScheduler::Boolean> id) {
   wireKeeper_->decreaseReferenceCount(id);
 }
 
-void LazyScheduler::decreaseReferenceCountBatch(
+template <typename WireKeeperT>
+void BasicLazyScheduler<WireKeeperT>::decreaseReferenceCountBatch(
     WireId<IScheduler::Boolean> id) {
   wireKeeper_->decreaseBatchReferenceCount(id);
 }
 
-std::pair<uint64_t, uint64_t> LazyScheduler::getTrafficStatistics() const {
+template <typename WireKeeperT>
+std::pair<uint64_t, uint64_t>
+BasicLazyScheduler<WireKeeperT>::getTrafficStatistics() const {
   return engine_->getTrafficStatistics();
 }
 
 // band a number of batches into one batch.
-IScheduler::WireId<IScheduler::Boolean> LazyScheduler::batchingUp(
-    std::vector<WireId<Boolean>> src) {
+template <typename WireKeeperT>
+IScheduler::WireId<IScheduler::Boolean>
+BasicLazyScheduler<WireKeeperT>::batchingUp(std::vector<WireId<Boolean>> src) {
   maybeExecuteGates();
   return gateKeeper_->batchingUp(src);
 }
 
 // decompose a batch of values into several smaller batches.
-std::vector<IScheduler::WireId<IScheduler::Boolean>> LazyScheduler::unbatching(
+template <typename WireKeeperT>
+std::vector<IScheduler::WireId<IScheduler::Boolean>>
+BasicLazyScheduler<WireKeeperT>::unbatching(
     WireId<Boolean> src,
     std::shared_ptr<std::vector<uint32_t>> unbatchingStrategy) {
   auto rst = gateKeeper_->unbatching(src, unbatchingStrategy);
@@ -346,8 +412,9 @@ std::vector<IScheduler::WireId<IScheduler::Boolean>> LazyScheduler::unbatching(
   return rst;
 }
 
+template <typename WireKeeperT>
 template <bool usingBatch>
-IGateKeeper::BoolType<usingBatch> LazyScheduler::forceWire(
+IGateKeeper::BoolType<usingBatch> BasicLazyScheduler<WireKeeperT>::forceWire(
     IScheduler::WireId<IScheduler::Boolean> id) {
   if constexpr (usingBatch) {
     executeTillLevel(wireKeeper_->getBatchFirstAvailableLevel(id));
@@ -358,19 +425,22 @@ IGateKeeper::BoolType<usingBatch> LazyScheduler::forceWire(
   }
 }
 
-void LazyScheduler::maybeExecuteGates() {
+template <typename WireKeeperT>
+void BasicLazyScheduler<WireKeeperT>::maybeExecuteGates() {
   while (gateKeeper_->hasReachedBatchingLimit()) {
     executeOneLevel();
   }
 }
 
-void LazyScheduler::executeTillLevel(uint32_t level) {
+template <typename WireKeeperT>
+void BasicLazyScheduler<WireKeeperT>::executeTillLevel(uint32_t level) {
   while (gateKeeper_->getFirstUnexecutedLevel() <= level) {
     executeOneLevel();
   }
 }
 
-void LazyScheduler::executeOneLevel() {
+template <typename WireKeeperT>
+void BasicLazyScheduler<WireKeeperT>::executeOneLevel() {
   auto level = gateKeeper_->getFirstUnexecutedLevel();
   auto gates = gateKeeper_->popFirstUnexecutedLevel();
   auto isLevelFree = IGateKeeper::isLevelFree(level);
@@ -404,4 +474,10 @@ void LazyScheduler::executeOneLevel() {
   }
 }
 
+template class BasicLazyScheduler<IWireKeeper>;
+template class BasicLazyScheduler<
+    BasicWireKeeper<VectorArenaAllocatorPolicy<true>>>;
+template class BasicLazyScheduler<
+    BasicWireKeeper<VectorArenaAllocatorPolicy<false>>>;
+
 } // namespace fbpcf::scheduler
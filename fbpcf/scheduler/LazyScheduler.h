@@ -11,6 +11,7 @@
 #include "fbpcf/engine/ISecretShareEngine.h"
 #include "fbpcf/scheduler/IScheduler.h"
 #include "fbpcf/scheduler/IWireKeeper.h"
+#include "fbpcf/scheduler/WireKeeper.h"
 #include "fbpcf/scheduler/gate_keeper/IGateKeeper.h"
 
 namespace fbpcf::scheduler {
@@ -19,13 +20,15 @@ namespace fbpcf::scheduler {
  * A "lazy" scheduler decouples the execution of the frontend
  * application with the MPC protocol. Gates are batched together
  * and executed lazily to reduce roundtrips. It is cryptographically
- * secure if the underlying secret sharing engine is.
+ * secure if the underlying secret sharing engine is. The wire keeper is called
+ * through WireKeeperT, see BasicGateKeeper.
  */
-class LazyScheduler final : public IScheduler {
+template <typename WireKeeperT>
+class BasicLazyScheduler final : public IScheduler {
  public:
-  explicit LazyScheduler(
+  explicit BasicLazyScheduler(
       std::unique_ptr<engine::ISecretShareEngine> engine,
-      std::shared_ptr<IWireKeeper> wireKeeper,
+      std::shared_ptr<WireKeeperT> wireKeeper,
       std::unique_ptr<IGateKeeper> gateKeeper);
 
   //======== Below are input processing APIs: ========
@@ -309,7 +312,7 @@ class LazyScheduler final : public IScheduler {
 
  private:
   std::unique_ptr<engine::ISecretShareEngine> engine_;
-  std::shared_ptr<IWireKeeper> wireKeeper_;
+  std::shared_ptr<WireKeeperT> wireKeeper_;
   std::unique_ptr<IGateKeeper> gateKeeper_;
 
   // Compute the value for the given wire if it hasn't been set already.
@@ -325,4 +328,12 @@ class LazyScheduler final : public IScheduler {
   void executeOneLevel();
 };
 
+using LazyScheduler = BasicLazyScheduler<IWireKeeper>;
+
+extern template class BasicLazyScheduler<IWireKeeper>;
+extern template class BasicLazyScheduler<
+    BasicWireKeeper<VectorArenaAllocatorPolicy<true>>>;
+extern template class BasicLazyScheduler<
+    BasicWireKeeper<VectorArenaAllocatorPolicy<false>>>;
+
 } // namespace fbpcf::scheduler
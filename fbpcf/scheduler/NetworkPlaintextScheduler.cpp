@@ -51,7 +51,7 @@ NetworkPlaintextScheduler::privateBooleanInputBatch(
     return wireKeeper_->allocateBatchBooleanValue(v);
   }
   auto otherV = agentMap_.at(partyId)->receiveBool(v.size());
-  return wireKeeper_->allocateBatchBooleanValue(otherV);
+  return wireKeeper_->allocateBatchBooleanValue(std::move(otherV));
 }
 
 IScheduler::WireId<IScheduler::Boolean>
@@ -97,7 +97,7 @@ NetworkPlaintextScheduler::recoverBooleanWireBatch(const std::vector<bool>& v) {
     }
   }
 
-  return wireKeeper_->allocateBatchBooleanValue(result);
+  return wireKeeper_->allocateBatchBooleanValue(std::move(result));
 }
 
 bool NetworkPlaintextScheduler::extractBooleanSecretShare(
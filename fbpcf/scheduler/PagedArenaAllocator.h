@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "fbpcf/scheduler/IAllocator.h"
+
+namespace fbpcf::scheduler {
+
+/**
+ * This class stores objects in pages whose sizes grow geometrically. Pages are
+ * never moved or copied once allocated, so growing the arena costs one page
+ * allocation instead of a reallocation of every existing object.
+ *
+ * Every slot carries a generation counter that is bumped on both allocation
+ * and free (odd means live), so the safe version detects accesses to freed
+ * slots without extra storage.
+ *
+ * The "unsafe" version does not guard against accessing unallocated or freed
+ * memory locations.
+ */
+template <typename T, bool unsafe>
+class PagedArenaAllocator final : public IAllocator<T> {
+ public:
+  PagedArenaAllocator() : nextAvailableBlockIndex_{0} {
+    increaseAllocation();
+  }
+
+  /**
+   * @inherit doc
+   */
+  uint64_t allocate(T&& value) override {
+    if (nextAvailableBlockIndex_ >= freeBlocks_.size()) {
+      increaseAllocation();
+    }
+    auto id = freeBlocks_[nextAvailableBlockIndex_++];
+    auto& slot = getSlot(id);
+    slot.value = std::move(value);
+    slot.generation++;
+    return id;
+  }
+
+  /**
+   * @inherit doc
+   */
+  void free(uint64_t id) override {
+    auto& slot = getSlot(id);
+    if constexpr (!unsafe) {
+      if (!isLive(slot)) {
+        throw std::runtime_error(IAllocator<T>::errorMessageCannotFindItem(id));
+      }
+    }
+    slot.generation++;
+    freeBlocks_[--nextAvailableBlockIndex_] = id;
+  }
+
+  /**
+   * @inherit doc
+   */
+  const T& get(uint64_t id) const override {
+    return getLiveSlot(id).value;
+  }
+
+  /**
+   * @inherit doc
+   */
+  T& getWritableReference(uint64_t id) override {
+    return const_cast<Slot&>(getLiveSlot(id)).value;
+  }
+
+  bool isSafe() const override {
+    return !unsafe;
+  }
+
+  // Number of slots currently backed by memory.
+  uint64_t getCapacity() const {
+    return freeBlocks_.size();
+  }
+
+ private:
+  static const uint64_t kFirstPageSize = 1024;
+
+  struct Slot {
+    T value;
+    uint64_t generation = 0;
+  };
+
+  static bool isLive(const Slot& slot) {
+    return slot.generation & 1;
+  }
+
+  // Page p holds kFirstPageSize * 2^p slots, starting at
+  // kFirstPageSize * (2^p - 1).
+  static std::pair<size_t, uint64_t> locate(uint64_t id) {
+    auto page = 63 - __builtin_clzll(id / kFirstPageSize + 1);
+    return {page, id - kFirstPageSize * ((uint64_t(1) << page) - 1)};
+  }
+
+  Slot& getSlot(uint64_t id) {
+    return const_cast<Slot&>(std::as_const(*this).getSlot(id));
+  }
+
+  const Slot& getSlot(uint64_t id) const {
+    auto [page, offset] = locate(id);
+    if constexpr (unsafe) {
+      return pages_[page][offset];
+    } else {
+      if (page >= pages_.size()) {
+        throw std::runtime_error(IAllocator<T>::errorMessageCannotFindItem(id));
+      }
+      return pages_[page][offset];
+    }
+  }
+
+  const Slot& getLiveSlot(uint64_t id) const {
+    auto& slot = getSlot(id);
+    if constexpr (!unsafe) {
+      if (!isLive(slot)) {
+        throw std::runtime_error(IAllocator<T>::errorMessageCannotFindItem(id));
+      }
+    }
+    return slot;
+  }
+
+  void increaseAllocation() {
+    uint64_t allocatedSize = freeBlocks_.size();
+    uint64_t pageSize = kFirstPageSize << pages_.size();
+    pages_.push_back(std::make_unique<Slot[]>(pageSize));
+    freeBlocks_.reserve(allocatedSize + pageSize);
+    for (uint64_t i = 0; i < pageSize; ++i) {
+      freeBlocks_.push_back(allocatedSize + i);
+    }
+  }
+
+  std::vector<std::unique_ptr<Slot[]>> pages_;
+  std::vector<uint64_t> freeBlocks_;
+  uint64_t nextAvailableBlockIndex_;
+};
+
+} // namespace fbpcf::scheduler
@@ -113,7 +113,7 @@ PlaintextScheduler::privateAndPrivateBatch(
   for (size_t i = 0; i < leftValue.size(); i++) {
     rst[i] = leftValue[i] & rightValue[i];
   }
-  return wireKeeper_->allocateBatchBooleanValue(rst);
+  return wireKeeper_->allocateBatchBooleanValue(std::move(rst));
 }
 
 IScheduler::WireId<IScheduler::Boolean> PlaintextScheduler::privateAndPublic(
@@ -138,7 +138,7 @@ PlaintextScheduler::privateAndPublicBatch(
   for (size_t i = 0; i < leftValue.size(); i++) {
     rst[i] = leftValue.at(i) & rightValue.at(i);
   }
-  return wireKeeper_->allocateBatchBooleanValue(rst);
+  return wireKeeper_->allocateBatchBooleanValue(std::move(rst));
 }
 
 IScheduler::WireId<IScheduler::Boolean> PlaintextScheduler::publicAndPublic(
@@ -218,7 +218,7 @@ PlaintextScheduler::privateXorPrivateBatch(
   for (size_t i = 0; i < leftValue.size(); i++) {
     rst[i] = leftValue[i] ^ rightValue[i];
   }
-  return wireKeeper_->allocateBatchBooleanValue(rst);
+  return wireKeeper_->allocateBatchBooleanValue(std::move(rst));
 }
 
 IScheduler::WireId<IScheduler::Boolean> PlaintextScheduler::privateXorPublic(
@@ -261,7 +261,7 @@ IScheduler::WireId<IScheduler::Boolean> PlaintextScheduler::notPrivateBatch(
   for (size_t i = 0; i < value.size(); i++) {
     rst[i] = !value[i];
   }
-  return wireKeeper_->allocateBatchBooleanValue(rst);
+  return wireKeeper_->allocateBatchBooleanValue(std::move(rst));
 }
 
 IScheduler::WireId<IScheduler::Boolean> PlaintextScheduler::notPublic(
@@ -313,19 +313,14 @@ PlaintextScheduler::computeCompositeAND(
 // band a number of batches into one batch.
 IScheduler::WireId<IScheduler::Boolean> PlaintextScheduler::batchingUp(
     std::vector<WireId<Boolean>> src) {
-  size_t batchSize = 0;
-  for (auto& item : src) {
-    batchSize += wireKeeper_->getBatchBooleanValue(item).size();
+  std::vector<IWireKeeper::BatchSlice> slices(src.size());
+  for (size_t i = 0; i < src.size(); i++) {
+    slices[i] = IWireKeeper::BatchSlice{
+        src.at(i), 0, wireKeeper_->getBatchBooleanSize(src.at(i))};
   }
-  std::vector<bool> vector(batchSize, 0);
-  size_t index = 0;
-  for (auto& item : src) {
-    auto& batch = wireKeeper_->getBatchBooleanValue(item);
-    for (auto v : batch) {
-      vector[index++] = v;
-    }
-  }
-  return wireKeeper_->allocateBatchBooleanValue(vector);
+  auto rst = wireKeeper_->allocateBatchBooleanValue(std::vector<bool>());
+  wireKeeper_->setBatchBooleanView(rst, slices);
+  return rst;
 }
 
 // decompose a batch of values into several smaller batches.
@@ -333,20 +328,19 @@ std::vector<IScheduler::WireId<IScheduler::Boolean>>
 PlaintextScheduler::unbatching(
     WireId<Boolean> src,
     std::shared_ptr<std::vector<uint32_t>> unbatchingStrategy) {
-  auto& batch = wireKeeper_->getBatchBooleanValue(src);
+  auto batchSize = wireKeeper_->getBatchBooleanSize(src);
   size_t index = 0;
   std::vector<IScheduler::WireId<IScheduler::Boolean>> rst(
       unbatchingStrategy->size());
   for (size_t i = 0; i < rst.size(); i++) {
-    std::vector<bool> v(unbatchingStrategy->at(i));
-    if (index + v.size() > batch.size()) {
+    size_t size = unbatchingStrategy->at(i);
+    if (index + size > batchSize) {
       throw std::runtime_error(
           "Failed to unbatch, you are unbatching to more values than the input has.");
     }
-    for (size_t j = 0; j < v.size(); j++) {
-      v[j] = batch.at(index++);
-    }
-    rst[i] = wireKeeper_->allocateBatchBooleanValue(v);
+    rst[i] = wireKeeper_->allocateBatchBooleanValue(std::vector<bool>());
+    wireKeeper_->setBatchBooleanView(rst[i], {{src, index, size}});
+    index += size;
   }
   return rst;
 }
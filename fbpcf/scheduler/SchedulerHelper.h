@@ -21,16 +21,65 @@
 
 namespace fbpcf::scheduler {
 
-template <bool unsafe>
+enum class WireKeeperType {
+  VectorArena,
+  // vector arenas whose allocator calls inside the wire keeper are direct,
+  // see VectorArenaAllocatorPolicy.
+  InlinedVectorArena,
+  // paged arenas, which grow without moving the existing wires.
+  PagedArena,
+};
+
+template <bool unsafe, WireKeeperType wireKeeperType>
+inline std::unique_ptr<IWireKeeper> createWireKeeper() {
+  if constexpr (wireKeeperType == WireKeeperType::InlinedVectorArena) {
+    return WireKeeper::createWithInlinedVectorArena<unsafe>();
+  } else if constexpr (wireKeeperType == WireKeeperType::PagedArena) {
+    return WireKeeper::createWithPagedArena<unsafe>();
+  } else {
+    return WireKeeper::createWithVectorArena<unsafe>();
+  }
+}
+
+template <bool unsafe, WireKeeperType wireKeeperType>
+inline std::unique_ptr<IScheduler> createLazyScheduler(
+    std::unique_ptr<engine::ISecretShareEngine> engine) {
+  if constexpr (wireKeeperType == WireKeeperType::InlinedVectorArena) {
+    // the gate keeper and its gates hold the concrete wire keeper, so that
+    // their reference counting doesn't go through IWireKeeper.
+    using WireKeeperT = BasicWireKeeper<VectorArenaAllocatorPolicy<unsafe>>;
+    std::shared_ptr<WireKeeperT> wireKeeper =
+        WireKeeper::createWithInlinedVectorArena<unsafe>();
+
+    return std::make_unique<BasicLazyScheduler<WireKeeperT>>(
+        std::move(engine),
+        wireKeeper,
+        std::make_unique<BasicGateKeeper<WireKeeperT>>(wireKeeper));
+  } else {
+    std::shared_ptr<IWireKeeper> wireKeeper =
+        createWireKeeper<unsafe, wireKeeperType>();
+
+    return std::make_unique<LazyScheduler>(
+        std::move(engine),
+        wireKeeper,
+        std::make_unique<GateKeeper>(wireKeeper));
+  }
+}
+
+template <
+    bool unsafe,
+    WireKeeperType wireKeeperType = WireKeeperType::VectorArena>
 inline std::unique_ptr<IScheduler> createPlaintextScheduler(
     int /*myId*/,
     engine::communication::IPartyCommunicationAgentFactory&
     /*communicationAgentFactory*/) {
   return std::make_unique<PlaintextScheduler>(
-      WireKeeper::createWithVectorArena<unsafe>());
+      createWireKeeper<unsafe, wireKeeperType>());
 }
 
-template <bool unsafe>
+template <
+    bool unsafe,
+    WireKeeperType wireKeeperType = WireKeeperType::VectorArena>
 inline std::unique_ptr<IScheduler> createNetworkPlaintextScheduler(
     int myId,
     engine::communication::IPartyCommunicationAgentFactory&
@@ -40,10 +89,13 @@ inline std::unique_ptr<IScheduler> createNetworkPlaintextScheduler(
       numberOfParties, myId, communicationAgentFactory);
 
   return std::make_unique<NetworkPlaintextScheduler>(
-      myId, std::move(agentMap), WireKeeper::createWithVectorArena<unsafe>());
+      myId,
+      std::move(agentMap),
+      createWireKeeper<unsafe, wireKeeperType>());
 }
 
 // this function creates a eager scheduler with real secure engine
+template <WireKeeperType wireKeeperType = WireKeeperType::VectorArena>
 inline std::unique_ptr<IScheduler> createEagerSchedulerWithRealEngine(
     int myId,
     engine::communication::IPartyCommunicationAgentFactory&
@@ -53,10 +105,11 @@ inline std::unique_ptr<IScheduler> createEagerSchedulerWithRealEngine(
 
   return std::make_unique<EagerScheduler>(
       engineFactory->create(),
-      WireKeeper::createWithVectorArena</*unsafe*/ true>());
+      createWireKeeper</*unsafe*/ true, wireKeeperType>());
 }
 
 // this function creates a lazy scheduler with real secure engine
+template <WireKeeperType wireKeeperType = WireKeeperType::VectorArena>
 inline std::unique_ptr<IScheduler> createLazySchedulerWithRealEngine(
     int myId,
     engine::communication::IPartyCommunicationAgentFactory&
@@ -64,15 +117,11 @@ inline std::unique_ptr<IScheduler> createLazySchedulerWithRealEngine(
   auto engineFactory = engine::getSecureEngineFactoryWithFERRET<bool>(
       myId, 2, communicationAgentFactory);
 
-  std::shared_ptr<IWireKeeper> wireKeeper =
-      WireKeeper::createWithVectorArena</*unsafe*/ true>();
-
-  return std::make_unique<LazyScheduler>(
-      engineFactory->create(),
-      wireKeeper,
-      std::make_unique<GateKeeper>(wireKeeper));
+  return createLazyScheduler</*unsafe*/ true, wireKeeperType>(
+      engineFactory->create());
 }
 
+template <WireKeeperType wireKeeperType = WireKeeperType::VectorArena>
 inline std::unique_ptr<IScheduler> createEagerSchedulerWithClassicOT(
     int myId,
     engine::communication::IPartyCommunicationAgentFactory&
@@ -82,9 +131,10 @@ inline std::unique_ptr<IScheduler> createEagerSchedulerWithClassicOT(
 
   return std::make_unique<EagerScheduler>(
       engineFactory->create(),
-      WireKeeper::createWithVectorArena</*unsafe*/ true>());
+      createWireKeeper</*unsafe*/ true, wireKeeperType>());
 }
 
+template <WireKeeperType wireKeeperType = WireKeeperType::VectorArena>
 inline std::unique_ptr<IScheduler> createLazySchedulerWithClassicOT(
     int myId,
     engine::communication::IPartyCommunicationAgentFactory&
@@ -92,17 +142,14 @@ inline std::unique_ptr<IScheduler> createLazySchedulerWithClassicOT(
   auto engineFactory = engine::getSecureEngineFactoryWithClassicOt<bool>(
       myId, 2, communicationAgentFactory);
 
-  std::shared_ptr<IWireKeeper> wireKeeper =
-      WireKeeper::createWithVectorArena</*unsafe*/ true>();
-
-  return std::make_unique<LazyScheduler>(
-      engineFactory->create(),
-      wireKeeper,
-      std::make_unique<GateKeeper>(wireKeeper));
+  return createLazyScheduler</*unsafe*/ true, wireKeeperType>(
+      engineFactory->create());
 }
 
 // this function creates a eager scheduler with insecure engine
-template <bool unsafe>
+template <
+    bool unsafe,
+    WireKeeperType wireKeeperType = WireKeeperType::VectorArena>
 inline std::unique_ptr<IScheduler> createEagerSchedulerWithInsecureEngine(
     int myId,
     engine::communication::IPartyCommunicationAgentFactory&
@@ -111,11 +158,14 @@ inline std::unique_ptr<IScheduler> createEagerSchedulerWithInsecureEngine(
       myId, 2, communicationAgentFactory);
 
   return std::make_unique<EagerScheduler>(
-      engineFactory->create(), WireKeeper::createWithVectorArena<unsafe>());
+      engineFactory->create(),
+      createWireKeeper<unsafe, wireKeeperType>());
 }
 
 // this function creates a lazy scheduler with insecure engine
-template <bool unsafe>
+template <
+    bool unsafe,
+    WireKeeperType wireKeeperType = WireKeeperType::VectorArena>
 inline std::unique_ptr<IScheduler> createLazySchedulerWithInsecureEngine(
     int myId,
     engine::communication::IPartyCommunicationAgentFactory&
@@ -123,13 +173,7 @@ inline std::unique_ptr<IScheduler> createLazySchedulerWithInsecureEngine(
   auto engineFactory = engine::getInsecureEngineFactoryWithDummyTupleGenerator(
       myId, 2, communicationAgentFactory);
 
-  std::shared_ptr<IWireKeeper> wireKeeper =
-      WireKeeper::createWithVectorArena<unsafe>();
-
-  return std::make_unique<LazyScheduler>(
-      engineFactory->create(),
-      wireKeeper,
-      std::make_unique<GateKeeper>(wireKeeper));
+  return createLazyScheduler<unsafe, wireKeeperType>(engineFactory->create());
 }
 
 } // namespace fbpcf::scheduler
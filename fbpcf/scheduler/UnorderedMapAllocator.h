@@ -8,6 +8,7 @@
 #pragma once
 
 #include <unordered_map>
+#include <utility>
 
 #include "fbpcf/scheduler/IAllocator.h"
 
@@ -23,7 +24,7 @@ class UnorderedMapAllocator final : public IAllocator<T> {
    * @inherit doc
    */
   uint64_t allocate(T&& value) override {
-    map_.emplace(nextId_, value);
+    map_.emplace(nextId_, std::move(value));
     return nextId_++;
   }
 
@@ -12,6 +12,7 @@
 #include <optional>
 #include <queue>
 #include <stdexcept>
+#include <utility>
 
 #include "fbpcf/scheduler/IAllocator.h"
 
@@ -40,7 +41,7 @@ class VectorArenaAllocator final : public IAllocator<T> {
       increaseAllocation();
     }
     auto id = freeBlocks_[nextAvailableBlockIndex_++];
-    blocks_[id] = value;
+    blocks_[id] = std::move(value);
     return id;
   }
 
@@ -59,7 +60,7 @@ class VectorArenaAllocator final : public IAllocator<T> {
    */
   const T& get(uint64_t id) const override {
     if constexpr (unsafe) {
-      return blocks_.at(id);
+      return blocks_[id];
     } else {
       if (blocks_.at(id) == std::nullopt) {
         throw std::runtime_error(IAllocator<T>::errorMessageCannotFindItem(id));
@@ -73,7 +74,7 @@ class VectorArenaAllocator final : public IAllocator<T> {
    */
   T& getWritableReference(uint64_t id) override {
     if constexpr (unsafe) {
-      return blocks_.at(id);
+      return blocks_[id];
     } else {
       if (blocks_.at(id) == std::nullopt) {
         throw std::runtime_error(IAllocator<T>::errorMessageCannotFindItem(id));
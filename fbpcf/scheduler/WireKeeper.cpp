@@ -6,6 +6,7 @@
  */
 
 #include "fbpcf/scheduler/WireKeeper.h"
+#include <algorithm>
 #include <cstdint>
 #include <exception>
 #include <stdexcept>
@@ -14,7 +15,21 @@
 
 namespace fbpcf::scheduler {
 
-IScheduler::WireId<IScheduler::Boolean> WireKeeper::allocateBooleanValue(
+namespace {
+
+inline size_t floorLog2(size_t n) {
+  return 63 - __builtin_clzll(n);
+}
+
+inline size_t ceilLog2(size_t n) {
+  return n <= 1 ? 0 : floorLog2(n - 1) + 1;
+}
+
+} // namespace
+
+template <typename AllocatorPolicy>
+IScheduler::WireId<IScheduler::Boolean>
+BasicWireKeeper<AllocatorPolicy>::allocateBooleanValue(
     bool v,
     uint32_t firstAvailableLevel) {
   wiresAllocated_++;
@@ -26,7 +41,9 @@ IScheduler::WireId<IScheduler::Boolean> WireKeeper::allocateBooleanValue(
   return IScheduler::WireId<IScheduler::Boolean>(wireID);
 }
 
-IScheduler::WireId<IScheduler::Arithmetic> WireKeeper::allocateIntegerValue(
+template <typename AllocatorPolicy>
+IScheduler::WireId<IScheduler::Arithmetic>
+BasicWireKeeper<AllocatorPolicy>::allocateIntegerValue(
     uint64_t v,
     uint32_t firstAvailableLevel) {
   wiresAllocated_++;
@@ -38,90 +55,85 @@ IScheduler::WireId<IScheduler::Arithmetic> WireKeeper::allocateIntegerValue(
   return IScheduler::WireId<IScheduler::Arithmetic>(wireID);
 }
 
-bool WireKeeper::getBooleanValue(
+template <typename AllocatorPolicy>
+bool BasicWireKeeper<AllocatorPolicy>::getBooleanValue(
     IScheduler::WireId<IScheduler::Boolean> id) const {
   return boolAllocator_->get(id.getId()).v;
 }
 
-uint64_t WireKeeper::getIntegerValue(
+template <typename AllocatorPolicy>
+uint64_t BasicWireKeeper<AllocatorPolicy>::getIntegerValue(
     IScheduler::WireId<IScheduler::Arithmetic> id) const {
   return intAllocator_->get(id.getId()).v;
 }
 
-void WireKeeper::setBooleanValue(
+template <typename AllocatorPolicy>
+void BasicWireKeeper<AllocatorPolicy>::setBooleanValue(
     IScheduler::WireId<IScheduler::Boolean> id,
     bool v) {
   boolAllocator_->getWritableReference(id.getId()).v = v;
 }
 
-void WireKeeper::setIntegerValue(
+template <typename AllocatorPolicy>
+void BasicWireKeeper<AllocatorPolicy>::setIntegerValue(
     IScheduler::WireId<IScheduler::Arithmetic> id,
     uint64_t v) {
   intAllocator_->getWritableReference(id.getId()).v = v;
 }
 
-uint32_t WireKeeper::getFirstAvailableLevel(
+template <typename AllocatorPolicy>
+uint32_t BasicWireKeeper<AllocatorPolicy>::getFirstAvailableLevel(
     IScheduler::WireId<IScheduler::Boolean> id) const {
   return boolAllocator_->get(id.getId()).firstAvailableLevel;
 }
 
-uint32_t WireKeeper::getFirstAvailableLevel(
+template <typename AllocatorPolicy>
+uint32_t BasicWireKeeper<AllocatorPolicy>::getFirstAvailableLevel(
     IScheduler::WireId<IScheduler::Arithmetic> id) const {
   return intAllocator_->get(id.getId()).firstAvailableLevel;
 }
 
-void WireKeeper::setFirstAvailableLevel(
+template <typename AllocatorPolicy>
+void BasicWireKeeper<AllocatorPolicy>::setFirstAvailableLevel(
     IScheduler::WireId<IScheduler::Boolean> id,
     uint32_t level) {
   boolAllocator_->getWritableReference(id.getId()).firstAvailableLevel = level;
 }
 
-void WireKeeper::setFirstAvailableLevel(
+template <typename AllocatorPolicy>
+void BasicWireKeeper<AllocatorPolicy>::setFirstAvailableLevel(
     IScheduler::WireId<IScheduler::Arithmetic> id,
     uint32_t level) {
   intAllocator_->getWritableReference(id.getId()).firstAvailableLevel = level;
 }
 
-void WireKeeper::increaseReferenceCount(
-    IScheduler::WireId<IScheduler::Boolean> id) {
-  boolAllocator_->getWritableReference(id.getId()).referenceCount++;
-}
-
-void WireKeeper::increaseReferenceCount(
-    IScheduler::WireId<IScheduler::Arithmetic> id) {
-  intAllocator_->getWritableReference(id.getId()).referenceCount++;
-}
-
-void WireKeeper::decreaseReferenceCount(
-    IScheduler::WireId<IScheduler::Boolean> id) {
-  if (--boolAllocator_->getWritableReference(id.getId()).referenceCount == 0) {
-    wiresDeallocated_++;
-    boolAllocator_->free(id.getId());
-  }
-}
-
-void WireKeeper::decreaseReferenceCount(
-    IScheduler::WireId<IScheduler::Arithmetic> id) {
-  if (--intAllocator_->getWritableReference(id.getId()).referenceCount == 0) {
-    wiresDeallocated_++;
-    intAllocator_->free(id.getId());
-  }
+template <typename AllocatorPolicy>
+IScheduler::WireId<IScheduler::Boolean>
+BasicWireKeeper<AllocatorPolicy>::allocateBatchBooleanValue(
+    const std::vector<bool>& v,
+    uint32_t firstAvailableLevel) {
+  auto buffer = takeRecycledBooleanBuffer(v.size());
+  buffer.assign(v.begin(), v.end());
+  return allocateBatchBooleanValue(std::move(buffer), firstAvailableLevel);
 }
 
-IScheduler::WireId<IScheduler::Boolean> WireKeeper::allocateBatchBooleanValue(
-    const std::vector<bool>& v,
+template <typename AllocatorPolicy>
+IScheduler::WireId<IScheduler::Boolean>
+BasicWireKeeper<AllocatorPolicy>::allocateBatchBooleanValue(
+    std::vector<bool>&& v,
     uint32_t firstAvailableLevel) {
   wiresAllocated_++;
-  auto wireID = boolBatchAllocator_->allocate(WireRecord<std::vector<bool>>{
-      .v = v,
+  auto wireID = boolBatchAllocator_->allocate(BatchBooleanWireRecord{
+      .v = std::move(v),
       .firstAvailableLevel = firstAvailableLevel,
       .referenceCount = 1,
   });
   return IScheduler::WireId<IScheduler::Boolean>(wireID);
 }
 
+template <typename AllocatorPolicy>
 IScheduler::WireId<IScheduler::Arithmetic>
-WireKeeper::allocateBatchIntegerValue(
+BasicWireKeeper<AllocatorPolicy>::allocateBatchIntegerValue(
     const std::vector<uint64_t>& v,
     uint32_t firstAvailableLevel) {
   wiresAllocated_++;
@@ -133,87 +145,261 @@ WireKeeper::allocateBatchIntegerValue(
   return IScheduler::WireId<IScheduler::Arithmetic>(wireID);
 }
 
-const std::vector<bool>& WireKeeper::getBatchBooleanValue(
+template <typename AllocatorPolicy>
+const std::vector<bool>& BasicWireKeeper<AllocatorPolicy>::getBatchBooleanValue(
     IScheduler::WireId<IScheduler::Boolean> id) const {
-  return boolBatchAllocator_->get(id.getId()).v;
+  auto& record = boolBatchAllocator_->get(id.getId());
+  if (record.viewSlices.empty() || record.viewResolved) {
+    return record.v;
+  }
+  return getBatchBooleanViewValue(record);
 }
 
-const std::vector<uint64_t>& WireKeeper::getBatchIntegerValue(
+template <typename AllocatorPolicy>
+const std::vector<uint64_t>&
+BasicWireKeeper<AllocatorPolicy>::getBatchIntegerValue(
     IScheduler::WireId<IScheduler::Arithmetic> id) const {
   return intBatchAllocator_->get(id.getId()).v;
 }
 
-std::vector<bool>& WireKeeper::getWritableBatchBooleanValue(
+template <typename AllocatorPolicy>
+std::vector<bool>&
+BasicWireKeeper<AllocatorPolicy>::getWritableBatchBooleanValue(
     IScheduler::WireId<IScheduler::Boolean> id) const {
-  return boolBatchAllocator_->getWritableReference(id.getId()).v;
+  auto& record = boolBatchAllocator_->getWritableReference(id.getId());
+  // copy on write
+  if (!record.viewSlices.empty() && !record.viewResolved) {
+    resolveBatchBooleanView(record);
+  }
+  return record.v;
 }
 
-std::vector<uint64_t>& WireKeeper::getWritableBatchIntegerValue(
+template <typename AllocatorPolicy>
+std::vector<uint64_t>&
+BasicWireKeeper<AllocatorPolicy>::getWritableBatchIntegerValue(
     IScheduler::WireId<IScheduler::Arithmetic> id) const {
   return intBatchAllocator_->getWritableReference(id.getId()).v;
 }
 
-void WireKeeper::setBatchBooleanValue(
+template <typename AllocatorPolicy>
+void BasicWireKeeper<AllocatorPolicy>::setBatchBooleanValue(
     IScheduler::WireId<IScheduler::Boolean> id,
     const std::vector<bool>& v) {
-  boolBatchAllocator_->getWritableReference(id.getId()).v = v;
+  auto& record = boolBatchAllocator_->getWritableReference(id.getId());
+  if (!record.viewSlices.empty()) {
+    releaseBatchBooleanView(id);
+  }
+  record.v = v;
 }
 
-void WireKeeper::setBatchIntegerValue(
+template <typename AllocatorPolicy>
+void BasicWireKeeper<AllocatorPolicy>::setBatchIntegerValue(
     IScheduler::WireId<IScheduler::Arithmetic> id,
     const std::vector<uint64_t>& v) {
   intBatchAllocator_->getWritableReference(id.getId()).v = v;
 }
 
-uint32_t WireKeeper::getBatchFirstAvailableLevel(
+template <typename AllocatorPolicy>
+size_t BasicWireKeeper<AllocatorPolicy>::getBatchBooleanSize(
+    IScheduler::WireId<IScheduler::Boolean> id) const {
+  auto& record = boolBatchAllocator_->get(id.getId());
+  return record.viewSlices.empty() || record.viewResolved ? record.v.size()
+                                                          : record.viewSize;
+}
+
+template <typename AllocatorPolicy>
+void BasicWireKeeper<AllocatorPolicy>::setBatchBooleanView(
+    IScheduler::WireId<IScheduler::Boolean> id,
+    const std::vector<BatchSlice>& slices) {
+  size_t size = 0;
+  for (auto& slice : slices) {
+    if (slice.offset + slice.length > getBatchBooleanSize(slice.src)) {
+      throw std::runtime_error(
+          "Failed to create view, the slice exceeds the size of its source.");
+    }
+    size += slice.length;
+  }
+  // increase first, the new slices may refer to the current view's sources.
+  for (auto& slice : slices) {
+    increaseBatchReferenceCount(slice.src);
+  }
+  auto& record = boolBatchAllocator_->getWritableReference(id.getId());
+  if (!record.viewSlices.empty()) {
+    releaseBatchBooleanView(id);
+  }
+  recycleBooleanBuffer(std::move(record.v));
+  record.v = std::vector<bool>();
+  record.viewSlices = slices;
+  record.viewSize = size;
+  record.viewResolved = false;
+}
+
+template <typename AllocatorPolicy>
+uint32_t BasicWireKeeper<AllocatorPolicy>::getBatchFirstAvailableLevel(
     IScheduler::WireId<IScheduler::Boolean> id) const {
   return boolBatchAllocator_->get(id.getId()).firstAvailableLevel;
 }
 
-uint32_t WireKeeper::getBatchFirstAvailableLevel(
+template <typename AllocatorPolicy>
+uint32_t BasicWireKeeper<AllocatorPolicy>::getBatchFirstAvailableLevel(
     IScheduler::WireId<IScheduler::Arithmetic> id) const {
   return intBatchAllocator_->get(id.getId()).firstAvailableLevel;
 }
 
-void WireKeeper::setBatchFirstAvailableLevel(
+template <typename AllocatorPolicy>
+void BasicWireKeeper<AllocatorPolicy>::setBatchFirstAvailableLevel(
     IScheduler::WireId<IScheduler::Boolean> id,
     uint32_t level) {
   boolBatchAllocator_->getWritableReference(id.getId()).firstAvailableLevel =
       level;
 }
 
-void WireKeeper::setBatchFirstAvailableLevel(
+template <typename AllocatorPolicy>
+void BasicWireKeeper<AllocatorPolicy>::setBatchFirstAvailableLevel(
     IScheduler::WireId<IScheduler::Arithmetic> id,
     uint32_t level) {
   intBatchAllocator_->getWritableReference(id.getId()).firstAvailableLevel =
       level;
 }
 
-void WireKeeper::increaseBatchReferenceCount(
-    IScheduler::WireId<IScheduler::Boolean> id) {
-  boolBatchAllocator_->getWritableReference(id.getId()).referenceCount++;
+template <typename AllocatorPolicy>
+void BasicWireKeeper<AllocatorPolicy>::freeBooleanWire(uint64_t id) {
+  wiresDeallocated_++;
+  boolAllocator_->free(id);
+}
+
+template <typename AllocatorPolicy>
+void BasicWireKeeper<AllocatorPolicy>::freeIntegerWire(uint64_t id) {
+  wiresDeallocated_++;
+  intAllocator_->free(id);
+}
+
+template <typename AllocatorPolicy>
+void BasicWireKeeper<AllocatorPolicy>::freeBatchBooleanWire(uint64_t id) {
+  wiresDeallocated_++;
+  auto& record = boolBatchAllocator_->getWritableReference(id);
+  if (!record.viewSlices.empty()) {
+    releaseBatchBooleanView(IScheduler::WireId<IScheduler::Boolean>(id));
+  }
+  recycleBooleanBuffer(std::move(record.v));
+  boolBatchAllocator_->free(id);
+}
+
+template <typename AllocatorPolicy>
+void BasicWireKeeper<AllocatorPolicy>::freeBatchIntegerWire(uint64_t id) {
+  wiresDeallocated_++;
+  intBatchAllocator_->free(id);
+}
+
+template <typename AllocatorPolicy>
+const std::vector<bool>&
+BasicWireKeeper<AllocatorPolicy>::getBatchBooleanViewValue(
+    const BatchBooleanWireRecord& record) const {
+  if (record.viewSlices.size() == 1) {
+    auto& slice = record.viewSlices.at(0);
+    auto& src = boolBatchAllocator_->get(slice.src.getId());
+    if (slice.offset == 0 &&
+        (src.viewSlices.empty() || src.viewResolved) &&
+        src.v.size() == slice.length) {
+      return src.v;
+    }
+  }
+  resolveBatchBooleanView(record);
+  return record.v;
 }
 
-void WireKeeper::increaseBatchReferenceCount(
-    IScheduler::WireId<IScheduler::Arithmetic> id) {
-  intBatchAllocator_->getWritableReference(id.getId()).referenceCount++;
+template <typename AllocatorPolicy>
+void BasicWireKeeper<AllocatorPolicy>::resolveBatchBooleanView(
+    const BatchBooleanWireRecord& record) const {
+  record.v.resize(record.viewSize);
+  auto dst = record.v.begin();
+  for (auto& slice : record.viewSlices) {
+    copyBatchBooleanValues(slice.src, slice.offset, slice.length, dst);
+    dst += slice.length;
+  }
+  record.viewResolved = true;
 }
 
-void WireKeeper::decreaseBatchReferenceCount(
+template <typename AllocatorPolicy>
+void BasicWireKeeper<AllocatorPolicy>::releaseBatchBooleanView(
     IScheduler::WireId<IScheduler::Boolean> id) {
-  if (--boolBatchAllocator_->getWritableReference(id.getId()).referenceCount ==
-      0) {
-    wiresDeallocated_++;
-    boolBatchAllocator_->free(id.getId());
+  auto slices = std::move(
+      boolBatchAllocator_->getWritableReference(id.getId()).viewSlices);
+  boolBatchAllocator_->getWritableReference(id.getId()).viewSlices.clear();
+  for (auto& slice : slices) {
+    decreaseBatchReferenceCount(slice.src);
+  }
+}
+
+template <typename AllocatorPolicy>
+void BasicWireKeeper<AllocatorPolicy>::copyBatchBooleanValues(
+    IScheduler::WireId<IScheduler::Boolean> src,
+    size_t offset,
+    size_t length,
+    std::vector<bool>::iterator dst) const {
+  auto& record = boolBatchAllocator_->get(src.getId());
+  if (record.viewSlices.empty() || record.viewResolved) {
+    std::copy(
+        record.v.begin() + offset, record.v.begin() + offset + length, dst);
+    return;
+  }
+  for (auto& slice : record.viewSlices) {
+    if (length == 0) {
+      break;
+    }
+    if (offset >= slice.length) {
+      offset -= slice.length;
+      continue;
+    }
+    auto count = std::min(length, slice.length - offset);
+    copyBatchBooleanValues(slice.src, slice.offset + offset, count, dst);
+    dst += count;
+    length -= count;
+    offset = 0;
+  }
+}
+
+template <typename AllocatorPolicy>
+std::vector<bool>
+BasicWireKeeper<AllocatorPolicy>::takeRecycledBooleanBuffer(size_t size) {
+  if (size == 0) {
+    return std::vector<bool>();
   }
+  // Any buffer in bucket b has a capacity of at least 2^b. Only look one
+  // bucket up so that large buffers are not used up by small batches.
+  auto bucket = ceilLog2(size);
+  for (auto b = bucket; b < std::min(bucket + 2, recycledBoolBuffers_.size());
+       b++) {
+    auto& buffers = recycledBoolBuffers_.at(b);
+    if (!buffers.empty()) {
+      auto buffer = std::move(buffers.back());
+      buffers.pop_back();
+      return buffer;
+    }
+  }
+  return std::vector<bool>();
 }
 
-void WireKeeper::decreaseBatchReferenceCount(
-    IScheduler::WireId<IScheduler::Arithmetic> id) {
-  if (--intBatchAllocator_->getWritableReference(id.getId()).referenceCount ==
-      0) {
-    wiresDeallocated_++;
-    intBatchAllocator_->free(id.getId());
+template <typename AllocatorPolicy>
+void
+BasicWireKeeper<AllocatorPolicy>::recycleBooleanBuffer(
+    std::vector<bool>&& buffer) {
+  if (buffer.capacity() == 0) {
+    return;
+  }
+  auto bucket = floorLog2(buffer.capacity());
+  if (recycledBoolBuffers_.size() <= bucket) {
+    recycledBoolBuffers_.resize(bucket + 1);
+  }
+  auto& buffers = recycledBoolBuffers_.at(bucket);
+  if (buffers.size() < kMaxRecycledBuffersPerBucket) {
+    buffer.clear();
+    buffers.push_back(std::move(buffer));
   }
 }
+
+template class BasicWireKeeper<DynamicAllocatorPolicy>;
+template class BasicWireKeeper<VectorArenaAllocatorPolicy<true>>;
+template class BasicWireKeeper<VectorArenaAllocatorPolicy<false>>;
+
 } // namespace fbpcf::scheduler
@@ -11,25 +11,45 @@
 #include <cassert>
 #include <memory>
 #include <string>
-#include <unordered_map>
 #include <utility>
 #include <vector>
 
 #include "fbpcf/scheduler/IAllocator.h"
 #include "fbpcf/scheduler/IWireKeeper.h"
+#include "fbpcf/scheduler/PagedArenaAllocator.h"
 #include "fbpcf/scheduler/UnorderedMapAllocator.h"
 #include "fbpcf/scheduler/VectorArenaAllocator.h"
 
 namespace fbpcf::scheduler {
 
-class WireKeeper final : public IWireKeeper {
+// Stores the wires behind IAllocator pointers, i.e. any allocator
+// implementation can be plugged in at runtime.
+struct DynamicAllocatorPolicy {
+  template <typename T>
+  using Allocator = IAllocator<T>;
+};
+
+// Stores the wires in vector arenas whose concrete (final) type is known at
+// compile time, so that the allocator calls inside the wire keeper are direct
+// and can be inlined. Callers that hold the wire keeper by its concrete type,
+// e.g. BasicGateKeeper and its gates, also call it directly.
+template <bool unsafe>
+struct VectorArenaAllocatorPolicy {
+  template <typename T>
+  using Allocator = VectorArenaAllocator<T, unsafe>;
+};
+
+template <typename AllocatorPolicy>
+class BasicWireKeeper final : public IWireKeeper {
+  template <typename T>
+  using Allocator = typename AllocatorPolicy::template Allocator<T>;
+
  public:
-  WireKeeper(
-      std::unique_ptr<IAllocator<WireRecord<bool>>> boolAllocator,
-      std::unique_ptr<IAllocator<WireRecord<std::vector<bool>>>>
-          boolBatchAllocator,
-      std::unique_ptr<IAllocator<WireRecord<uint64_t>>> intAllocator,
-      std::unique_ptr<IAllocator<WireRecord<std::vector<uint64_t>>>>
+  BasicWireKeeper(
+      std::unique_ptr<Allocator<WireRecord<bool>>> boolAllocator,
+      std::unique_ptr<Allocator<BatchBooleanWireRecord>> boolBatchAllocator,
+      std::unique_ptr<Allocator<WireRecord<uint64_t>>> intAllocator,
+      std::unique_ptr<Allocator<WireRecord<std::vector<uint64_t>>>>
           intBatchAllocator_)
       : boolAllocator_{std::move(boolAllocator)},
         boolBatchAllocator_{std::move(boolBatchAllocator)},
@@ -38,20 +58,44 @@ class WireKeeper final : public IWireKeeper {
 
   template <bool unsafe>
   static std::unique_ptr<IWireKeeper> createWithVectorArena() {
-    return std::make_unique<WireKeeper>(
+    return std::make_unique<BasicWireKeeper<DynamicAllocatorPolicy>>(
         std::make_unique<VectorArenaAllocator<WireRecord<bool>, unsafe>>(),
         std::make_unique<
-            VectorArenaAllocator<WireRecord<std::vector<bool>>, unsafe>>(),
+            VectorArenaAllocator<BatchBooleanWireRecord, unsafe>>(),
+        std::make_unique<VectorArenaAllocator<WireRecord<uint64_t>, unsafe>>(),
+        std::make_unique<
+            VectorArenaAllocator<WireRecord<std::vector<uint64_t>>, unsafe>>());
+  }
+
+  template <bool unsafe>
+  static std::unique_ptr<IWireKeeper> createWithPagedArena() {
+    return std::make_unique<BasicWireKeeper<DynamicAllocatorPolicy>>(
+        std::make_unique<PagedArenaAllocator<WireRecord<bool>, unsafe>>(),
+        std::make_unique<
+            PagedArenaAllocator<BatchBooleanWireRecord, unsafe>>(),
+        std::make_unique<PagedArenaAllocator<WireRecord<uint64_t>, unsafe>>(),
+        std::make_unique<
+            PagedArenaAllocator<WireRecord<std::vector<uint64_t>>, unsafe>>());
+  }
+
+  template <bool unsafe>
+  static std::unique_ptr<BasicWireKeeper<VectorArenaAllocatorPolicy<unsafe>>>
+  createWithInlinedVectorArena() {
+    return std::make_unique<
+        BasicWireKeeper<VectorArenaAllocatorPolicy<unsafe>>>(
+        std::make_unique<VectorArenaAllocator<WireRecord<bool>, unsafe>>(),
+        std::make_unique<
+            VectorArenaAllocator<BatchBooleanWireRecord, unsafe>>(),
         std::make_unique<VectorArenaAllocator<WireRecord<uint64_t>, unsafe>>(),
         std::make_unique<
             VectorArenaAllocator<WireRecord<std::vector<uint64_t>>, unsafe>>());
   }
 
   static std::unique_ptr<IWireKeeper> createWithUnorderedMap() {
-    return std::make_unique<WireKeeper>(
+    return std::make_unique<BasicWireKeeper<DynamicAllocatorPolicy>>(
         std::make_unique<UnorderedMapAllocator<WireRecord<bool>>>(),
         std::make_unique<
-            UnorderedMapAllocator<WireRecord<std::vector<bool>>>>(),
+            UnorderedMapAllocator<BatchBooleanWireRecord>>(),
         std::make_unique<UnorderedMapAllocator<WireRecord<uint64_t>>>(),
         std::make_unique<
             UnorderedMapAllocator<WireRecord<std::vector<uint64_t>>>>());
@@ -126,25 +170,39 @@ class WireKeeper final : public IWireKeeper {
    * @inherit doc
    */
   void increaseReferenceCount(
-      IScheduler::WireId<IScheduler::Boolean> id) override;
+      IScheduler::WireId<IScheduler::Boolean> id) override {
+    boolAllocator_->getWritableReference(id.getId()).referenceCount++;
+  }
 
   /**
    * @inherit doc
    */
   void increaseReferenceCount(
-      IScheduler::WireId<IScheduler::Arithmetic> id) override;
+      IScheduler::WireId<IScheduler::Arithmetic> id) override {
+    intAllocator_->getWritableReference(id.getId()).referenceCount++;
+  }
 
   /**
    * @inherit doc
    */
   void decreaseReferenceCount(
-      IScheduler::WireId<IScheduler::Boolean> id) override;
+      IScheduler::WireId<IScheduler::Boolean> id) override {
+    if (--boolAllocator_->getWritableReference(id.getId()).referenceCount ==
+        0) {
+      freeBooleanWire(id.getId());
+    }
+  }
 
   /**
    * @inherit doc
    */
   void decreaseReferenceCount(
-      IScheduler::WireId<IScheduler::Arithmetic> id) override;
+      IScheduler::WireId<IScheduler::Arithmetic> id) override {
+    if (--intAllocator_->getWritableReference(id.getId()).referenceCount ==
+        0) {
+      freeIntegerWire(id.getId());
+    }
+  }
 
   /**
    * @inherit doc
@@ -153,6 +211,13 @@ class WireKeeper final : public IWireKeeper {
       const std::vector<bool>& v,
       uint32_t firstAvailableLevel = 0) override;
 
+  /**
+   * @inherit doc
+   */
+  IScheduler::WireId<IScheduler::Boolean> allocateBatchBooleanValue(
+      std::vector<bool>&& v,
+      uint32_t firstAvailableLevel = 0) override;
+
   /**
    * @inherit doc
    */
@@ -194,6 +259,19 @@ class WireKeeper final : public IWireKeeper {
       IScheduler::WireId<IScheduler::Arithmetic> id,
       const std::vector<uint64_t>& v) override;
 
+  /**
+   * @inherit doc
+   */
+  size_t getBatchBooleanSize(
+      IScheduler::WireId<IScheduler::Boolean> id) const override;
+
+  /**
+   * @inherit doc
+   */
+  void setBatchBooleanView(
+      IScheduler::WireId<IScheduler::Boolean> id,
+      const std::vector<BatchSlice>& slices) override;
+
   /**
    * @inherit doc
    */
@@ -224,33 +302,89 @@ class WireKeeper final : public IWireKeeper {
    * @inherit doc
    */
   void increaseBatchReferenceCount(
-      IScheduler::WireId<IScheduler::Boolean> id) override;
+      IScheduler::WireId<IScheduler::Boolean> id) override {
+    boolBatchAllocator_->getWritableReference(id.getId()).referenceCount++;
+  }
 
   /**
    * @inherit doc
    */
   void increaseBatchReferenceCount(
-      IScheduler::WireId<IScheduler::Arithmetic> id) override;
+      IScheduler::WireId<IScheduler::Arithmetic> id) override {
+    intBatchAllocator_->getWritableReference(id.getId()).referenceCount++;
+  }
 
   /**
    * @inherit doc
    */
   void decreaseBatchReferenceCount(
-      IScheduler::WireId<IScheduler::Boolean> id) override;
+      IScheduler::WireId<IScheduler::Boolean> id) override {
+    if (--boolBatchAllocator_->getWritableReference(id.getId())
+              .referenceCount == 0) {
+      freeBatchBooleanWire(id.getId());
+    }
+  }
 
   /**
    * @inherit doc
    */
   void decreaseBatchReferenceCount(
-      IScheduler::WireId<IScheduler::Arithmetic> id) override;
+      IScheduler::WireId<IScheduler::Arithmetic> id) override {
+    if (--intBatchAllocator_->getWritableReference(id.getId())
+              .referenceCount == 0) {
+      freeBatchIntegerWire(id.getId());
+    }
+  }
 
  private:
-  std::unique_ptr<IAllocator<WireRecord<bool>>> boolAllocator_;
-  std::unique_ptr<IAllocator<WireRecord<std::vector<bool>>>>
+  void freeBooleanWire(uint64_t id);
+  void freeIntegerWire(uint64_t id);
+  void freeBatchBooleanWire(uint64_t id);
+  void freeBatchIntegerWire(uint64_t id);
+
+  // Freed boolean batch buffers are kept, bucketed by log2 of their capacity,
+  // and handed out again to later allocations of a similar size. This avoids
+  // most heap allocations in steady-state batch pipelines.
+  static const size_t kMaxRecycledBuffersPerBucket = 64;
+
+  std::vector<bool> takeRecycledBooleanBuffer(size_t size);
+
+  void recycleBooleanBuffer(std::vector<bool>&& buffer);
+
+  std::vector<std::vector<std::vector<bool>>> recycledBoolBuffers_;
+
+  // return the values of a view, this either forwards to the source wire (if
+  // the view covers exactly one whole wire) or resolves the view.
+  const std::vector<bool>& getBatchBooleanViewValue(
+      const BatchBooleanWireRecord& record) const;
+
+  // copy the view's values into the mutable cache of its record. The sources
+  // stay referenced until the view is overwritten or freed, see
+  // releaseBatchBooleanView().
+  void resolveBatchBooleanView(const BatchBooleanWireRecord& record) const;
+
+  // drop the view and release its sources.
+  void releaseBatchBooleanView(IScheduler::WireId<IScheduler::Boolean> id);
+
+  // copy `length` values of a wire, starting at `offset`, into dst.
+  void copyBatchBooleanValues(
+      IScheduler::WireId<IScheduler::Boolean> src,
+      size_t offset,
+      size_t length,
+      std::vector<bool>::iterator dst) const;
+
+  std::unique_ptr<Allocator<WireRecord<bool>>> boolAllocator_;
+  std::unique_ptr<Allocator<BatchBooleanWireRecord>>
       boolBatchAllocator_;
-  std::unique_ptr<IAllocator<WireRecord<uint64_t>>> intAllocator_;
-  std::unique_ptr<IAllocator<WireRecord<std::vector<uint64_t>>>>
+  std::unique_ptr<Allocator<WireRecord<uint64_t>>> intAllocator_;
+  std::unique_ptr<Allocator<WireRecord<std::vector<uint64_t>>>>
       intBatchAllocator_;
 };
 
+using WireKeeper = BasicWireKeeper<DynamicAllocatorPolicy>;
+
+extern template class BasicWireKeeper<DynamicAllocatorPolicy>;
+extern template class BasicWireKeeper<VectorArenaAllocatorPolicy<true>>;
+extern template class BasicWireKeeper<VectorArenaAllocatorPolicy<false>>;
+
 } // namespace fbpcf::scheduler
@@ -11,10 +11,12 @@
 #include <map>
 #include <stdexcept>
 
+#include "fbpcf/scheduler/IWireKeeper.h"
 #include "fbpcf/scheduler/gate_keeper/ICompositeGate.h"
 
 namespace fbpcf::scheduler {
 
+template <typename WireKeeperT = IWireKeeper>
 class BatchCompositeGate final : public ICompositeGate {
  public:
   BatchCompositeGate(
@@ -22,8 +24,9 @@ class BatchCompositeGate final : public ICompositeGate {
       std::vector<IScheduler::WireId<IScheduler::Boolean>> outputWireIDs,
       IScheduler::WireId<IScheduler::Boolean> left,
       std::vector<IScheduler::WireId<IScheduler::Boolean>> rights,
-      IWireKeeper& wireKeeper)
-      : ICompositeGate{gateType, outputWireIDs, left, rights, 0, wireKeeper} {
+      WireKeeperT& wireKeeper)
+      : ICompositeGate{gateType, outputWireIDs, left, rights, 0},
+        wireKeeper_{wireKeeper} {
     for (auto wireID : outputWireIDs_) {
       increaseReferenceCount(wireID);
     }
@@ -107,6 +110,9 @@ class BatchCompositeGate final : public ICompositeGate {
       wireKeeper_.decreaseBatchReferenceCount(wire);
     }
   }
+
+ private:
+  WireKeeperT& wireKeeper_;
 };
 
 } // namespace fbpcf::scheduler
@@ -9,11 +9,12 @@
 
 #include <map>
 
+#include "fbpcf/scheduler/IWireKeeper.h"
 #include "fbpcf/scheduler/gate_keeper/INormalGate.h"
 
 namespace fbpcf::scheduler {
 
-template <IScheduler::WireType T>
+template <IScheduler::WireType T, typename WireKeeperT = IWireKeeper>
 class BatchNormalGate final : public INormalGate<T> {
  public:
   using typename INormalGate<T>::GateType;
@@ -24,7 +25,6 @@ class BatchNormalGate final : public INormalGate<T> {
   using INormalGate<T>::partyID_;
   using INormalGate<T>::scheduledResultIndex_;
   using INormalGate<T>::numberOfResults_;
-  using INormalGate<T>::wireKeeper_;
   BatchNormalGate(
       GateType gateType,
       IScheduler::WireId<T> wireID,
@@ -32,15 +32,15 @@ class BatchNormalGate final : public INormalGate<T> {
       IScheduler::WireId<T> right,
       int partyID,
       uint32_t numberOfResults,
-      IWireKeeper& wireKeeper)
+      WireKeeperT& wireKeeper)
       : INormalGate<T>{
             gateType,
             wireID,
             left,
             right,
             partyID,
-            numberOfResults,
-            wireKeeper} {
+            numberOfResults},
+        wireKeeper_{wireKeeper} {
     increaseReferenceCount(wireID_);
     increaseReferenceCount(left_);
     increaseReferenceCount(right_);
@@ -166,6 +166,9 @@ class BatchNormalGate final : public INormalGate<T> {
       wireKeeper_.decreaseBatchReferenceCount(wire);
     }
   }
+
+ private:
+  WireKeeperT& wireKeeper_;
 };
 
 } // namespace fbpcf::scheduler
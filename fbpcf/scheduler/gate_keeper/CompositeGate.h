@@ -11,10 +11,12 @@
 #include <map>
 #include <stdexcept>
 
+#include "fbpcf/scheduler/IWireKeeper.h"
 #include "fbpcf/scheduler/gate_keeper/ICompositeGate.h"
 
 namespace fbpcf::scheduler {
 
+template <typename WireKeeperT = IWireKeeper>
 class CompositeGate final : public ICompositeGate {
  public:
   CompositeGate(
@@ -22,14 +24,14 @@ class CompositeGate final : public ICompositeGate {
       std::vector<IScheduler::WireId<IScheduler::Boolean>> outputWireIDs,
       IScheduler::WireId<IScheduler::Boolean> left,
       std::vector<IScheduler::WireId<IScheduler::Boolean>> rights,
-      IWireKeeper& wireKeeper)
+      WireKeeperT& wireKeeper)
       : ICompositeGate{
             gateType,
             outputWireIDs,
             left,
             rights,
-            static_cast<uint32_t>(outputWireIDs.size()),
-            wireKeeper} {
+            static_cast<uint32_t>(outputWireIDs.size())},
+        wireKeeper_{wireKeeper} {
     for (auto wireID : outputWireIDs_) {
       increaseReferenceCount(wireID);
     }
@@ -107,6 +109,9 @@ class CompositeGate final : public ICompositeGate {
       wireKeeper_.decreaseReferenceCount(wire);
     }
   }
+
+ private:
+  WireKeeperT& wireKeeper_;
 };
 
 } // namespace fbpcf::scheduler
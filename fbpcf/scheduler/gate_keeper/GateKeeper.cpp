@@ -16,10 +16,13 @@
 #include "fbpcf/scheduler/gate_keeper/NormalGate.h"
 
 namespace fbpcf::scheduler {
-GateKeeper::GateKeeper(std::shared_ptr<IWireKeeper> wireKeeper)
+template <typename WireKeeperT>
+BasicGateKeeper<WireKeeperT>::BasicGateKeeper(
+    std::shared_ptr<WireKeeperT> wireKeeper)
     : wireKeeper_{wireKeeper} {}
 
-IScheduler::WireId<IScheduler::Boolean> GateKeeper::inputGate(
+template <typename WireKeeperT>
+IScheduler::WireId<IScheduler::Boolean> BasicGateKeeper<WireKeeperT>::inputGate(
     BoolType<false> initialValue) {
   auto level = getOutputLevel(
       GateClass<false>::isFree(
@@ -27,7 +30,7 @@ IScheduler::WireId<IScheduler::Boolean> GateKeeper::inputGate(
       firstUnexecutedLevel_);
   auto outputWire = allocateNewWire(initialValue, level);
   addGate(
-      std::make_unique<NormalGate<IScheduler::Boolean>>(
+      std::make_unique<NormalGate<IScheduler::Boolean, WireKeeperT>>(
           INormalGate<IScheduler::Boolean>::GateType::Input,
           outputWire,
           IScheduler::WireId<IScheduler::Boolean>(),
@@ -38,8 +41,9 @@ IScheduler::WireId<IScheduler::Boolean> GateKeeper::inputGate(
   return outputWire;
 }
 
-IScheduler::WireId<IScheduler::Boolean> GateKeeper::inputGateBatch(
-    BoolType<true> initialValue) {
+template <typename WireKeeperT>
+IScheduler::WireId<IScheduler::Boolean>
+BasicGateKeeper<WireKeeperT>::inputGateBatch(BoolType<true> initialValue) {
   auto size = initialValue.size();
   auto level = getOutputLevel(
       GateClass<false>::isFree(
@@ -48,7 +52,7 @@ IScheduler::WireId<IScheduler::Boolean> GateKeeper::inputGateBatch(
 
   auto outputWire = allocateNewWire(initialValue, level);
   addGate(
-      std::make_unique<BatchNormalGate<IScheduler::Boolean>>(
+      std::make_unique<BatchNormalGate<IScheduler::Boolean, WireKeeperT>>(
           INormalGate<IScheduler::Boolean>::GateType::Input,
           outputWire,
           IScheduler::WireId<IScheduler::Boolean>(),
@@ -60,7 +64,9 @@ IScheduler::WireId<IScheduler::Boolean> GateKeeper::inputGateBatch(
   return outputWire;
 }
 
-IScheduler::WireId<IScheduler::Boolean> GateKeeper::outputGate(
+template <typename WireKeeperT>
+IScheduler::WireId<IScheduler::Boolean>
+BasicGateKeeper<WireKeeperT>::outputGate(
     IScheduler::WireId<IScheduler::Boolean> src,
     int partyID) {
   auto level = getOutputLevel(
@@ -70,7 +76,7 @@ IScheduler::WireId<IScheduler::Boolean> GateKeeper::outputGate(
   auto outputWire = allocateNewWire(false, level);
 
   addGate(
-      std::make_unique<NormalGate<IScheduler::Boolean>>(
+      std::make_unique<NormalGate<IScheduler::Boolean, WireKeeperT>>(
           INormalGate<IScheduler::Boolean>::GateType::Output,
           outputWire,
           src,
@@ -82,7 +88,9 @@ IScheduler::WireId<IScheduler::Boolean> GateKeeper::outputGate(
   return outputWire;
 }
 
-IScheduler::WireId<IScheduler::Boolean> GateKeeper::outputGateBatch(
+template <typename WireKeeperT>
+IScheduler::WireId<IScheduler::Boolean>
+BasicGateKeeper<WireKeeperT>::outputGateBatch(
     IScheduler::WireId<IScheduler::Boolean> src,
     int partyID) {
   auto level = getOutputLevel(
@@ -92,7 +100,7 @@ IScheduler::WireId<IScheduler::Boolean> GateKeeper::outputGateBatch(
   auto outputWire = allocateNewWire(std::vector<bool>(), level);
 
   addGate(
-      std::make_unique<BatchNormalGate<IScheduler::Boolean>>(
+      std::make_unique<BatchNormalGate<IScheduler::Boolean, WireKeeperT>>(
           INormalGate<IScheduler::Boolean>::GateType::Output,
           outputWire,
           src,
@@ -105,7 +113,9 @@ IScheduler::WireId<IScheduler::Boolean> GateKeeper::outputGateBatch(
   return outputWire;
 }
 
-IScheduler::WireId<IScheduler::Boolean> GateKeeper::normalGate(
+template <typename WireKeeperT>
+IScheduler::WireId<IScheduler::Boolean>
+BasicGateKeeper<WireKeeperT>::normalGate(
     INormalGate<IScheduler::Boolean>::GateType gateType,
     IScheduler::WireId<IScheduler::Boolean> left,
     IScheduler::WireId<IScheduler::Boolean> right) {
@@ -115,14 +125,16 @@ IScheduler::WireId<IScheduler::Boolean> GateKeeper::normalGate(
   auto outputWire = allocateNewWire(false, level);
 
   addGate(
-      std::make_unique<NormalGate<IScheduler::Boolean>>(
+      std::make_unique<NormalGate<IScheduler::Boolean, WireKeeperT>>(
           gateType, outputWire, left, right, 0, *wireKeeper_),
       level);
 
   return outputWire;
 }
 
-IScheduler::WireId<IScheduler::Boolean> GateKeeper::normalGateBatch(
+template <typename WireKeeperT>
+IScheduler::WireId<IScheduler::Boolean>
+BasicGateKeeper<WireKeeperT>::normalGateBatch(
     INormalGate<IScheduler::Boolean>::GateType gateType,
     IScheduler::WireId<IScheduler::Boolean> left,
     IScheduler::WireId<IScheduler::Boolean> right) {
@@ -132,14 +144,16 @@ IScheduler::WireId<IScheduler::Boolean> GateKeeper::normalGateBatch(
   auto outputWire = allocateNewWire(std::vector<bool>(), level);
 
   addGate(
-      std::make_unique<BatchNormalGate<IScheduler::Boolean>>(
+      std::make_unique<BatchNormalGate<IScheduler::Boolean, WireKeeperT>>(
           gateType, outputWire, left, right, 0, 0, *wireKeeper_),
       level);
 
   return outputWire;
 }
 
-std::vector<IScheduler::WireId<IScheduler::Boolean>> GateKeeper::compositeGate(
+template <typename WireKeeperT>
+std::vector<IScheduler::WireId<IScheduler::Boolean>>
+BasicGateKeeper<WireKeeperT>::compositeGate(
     ICompositeGate::GateType gateType,
     IScheduler::WireId<IScheduler::Boolean> left,
     std::vector<IScheduler::WireId<IScheduler::Boolean>> rights) {
@@ -154,15 +168,16 @@ std::vector<IScheduler::WireId<IScheduler::Boolean>> GateKeeper::compositeGate(
   }
 
   addGate(
-      std::make_unique<CompositeGate>(
+      std::make_unique<CompositeGate<WireKeeperT>>(
           gateType, outputWires, left, rights, *wireKeeper_),
       level);
 
   return outputWires;
 }
 
+template <typename WireKeeperT>
 std::vector<IScheduler::WireId<IScheduler::Boolean>>
-GateKeeper::compositeGateBatch(
+BasicGateKeeper<WireKeeperT>::compositeGateBatch(
     ICompositeGate::GateType gateType,
     IScheduler::WireId<IScheduler::Boolean> left,
     std::vector<IScheduler::WireId<IScheduler::Boolean>> rights) {
@@ -177,7 +192,7 @@ GateKeeper::compositeGateBatch(
   }
 
   addGate(
-      std::make_unique<BatchCompositeGate>(
+      std::make_unique<BatchCompositeGate<WireKeeperT>>(
           gateType, outputWires, left, rights, *wireKeeper_),
       level);
 
@@ -185,13 +200,11 @@ GateKeeper::compositeGateBatch(
 }
 
 // band a number of batches into one batch.
-IScheduler::WireId<IScheduler::Boolean> GateKeeper::batchingUp(
+template <typename WireKeeperT>
+IScheduler::WireId<IScheduler::Boolean>
+BasicGateKeeper<WireKeeperT>::batchingUp(
     std::vector<IScheduler::WireId<IScheduler::Boolean>> src) {
   auto level = getOutputLevel(true, getMaxLevel<true>(src));
-  uint32_t batchSize = 0;
-  for (auto& item : src) {
-    batchSize += wireKeeper_->getBatchBooleanValue(item).size();
-  }
   auto outputWire = allocateNewWire(std::vector<bool>(), level);
   addGate(
       std::make_unique<RebatchingBooleanGate>(src, outputWire, *wireKeeper_),
@@ -200,7 +213,9 @@ IScheduler::WireId<IScheduler::Boolean> GateKeeper::batchingUp(
 }
 
 // decompose a batch of values into several smaller batches.
-std::vector<IScheduler::WireId<IScheduler::Boolean>> GateKeeper::unbatching(
+template <typename WireKeeperT>
+std::vector<IScheduler::WireId<IScheduler::Boolean>>
+BasicGateKeeper<WireKeeperT>::unbatching(
     IScheduler::WireId<IScheduler::Boolean> src,
     std::shared_ptr<std::vector<uint32_t>> unbatchingStrategy) {
   auto level =
@@ -217,11 +232,14 @@ std::vector<IScheduler::WireId<IScheduler::Boolean>> GateKeeper::unbatching(
   return outputWires;
 }
 
-uint32_t GateKeeper::getFirstUnexecutedLevel() const {
+template <typename WireKeeperT>
+uint32_t BasicGateKeeper<WireKeeperT>::getFirstUnexecutedLevel() const {
   return firstUnexecutedLevel_;
 }
 
-std::vector<std::unique_ptr<IGate>> GateKeeper::popFirstUnexecutedLevel() {
+template <typename WireKeeperT>
+std::vector<std::unique_ptr<IGate>>
+BasicGateKeeper<WireKeeperT>::popFirstUnexecutedLevel() {
   auto gates = std::move(gatesByLevelOffset_.front());
   gatesByLevelOffset_.pop_front();
   ++firstUnexecutedLevel_;
@@ -229,8 +247,15 @@ std::vector<std::unique_ptr<IGate>> GateKeeper::popFirstUnexecutedLevel() {
   return gates;
 }
 
-bool GateKeeper::hasReachedBatchingLimit() const {
+template <typename WireKeeperT>
+bool BasicGateKeeper<WireKeeperT>::hasReachedBatchingLimit() const {
   return numUnexecutedGates_ > kMaxUnexecutedGates;
 }
 
+template class BasicGateKeeper<IWireKeeper>;
+template class BasicGateKeeper<
+    BasicWireKeeper<VectorArenaAllocatorPolicy<true>>>;
+template class BasicGateKeeper<
+    BasicWireKeeper<VectorArenaAllocatorPolicy<false>>>;
+
 } // namespace fbpcf::scheduler
@@ -11,13 +11,20 @@
 #include <memory>
 #include <stdexcept>
 
+#include "fbpcf/scheduler/WireKeeper.h"
 #include "fbpcf/scheduler/gate_keeper/IGateKeeper.h"
 
 namespace fbpcf::scheduler {
 
-class GateKeeper : public IGateKeeper {
+/**
+ * The gate keeper and its gates call the wire keeper through WireKeeperT. If
+ * it is a concrete wire keeper, e.g. from createWithInlinedVectorArena(), the
+ * reference counting of the gates is a direct call that can be inlined.
+ */
+template <typename WireKeeperT>
+class BasicGateKeeper : public IGateKeeper {
  public:
-  explicit GateKeeper(std::shared_ptr<IWireKeeper> wireKeeper);
+  explicit BasicGateKeeper(std::shared_ptr<WireKeeperT> wireKeeper);
 
   /**
    * @inherit doc
@@ -123,7 +130,7 @@ class GateKeeper : public IGateKeeper {
       IScheduler::WireId<IScheduler::Boolean>>::type;
 
   std::deque<std::vector<std::unique_ptr<IGate>>> gatesByLevelOffset_;
-  std::shared_ptr<IWireKeeper> wireKeeper_;
+  std::shared_ptr<WireKeeperT> wireKeeper_;
 
   uint32_t firstUnexecutedLevel_ = 0;
 
@@ -192,4 +199,12 @@ class GateKeeper : public IGateKeeper {
   }
 };
 
+using GateKeeper = BasicGateKeeper<IWireKeeper>;
+
+extern template class BasicGateKeeper<IWireKeeper>;
+extern template class BasicGateKeeper<
+    BasicWireKeeper<VectorArenaAllocatorPolicy<true>>>;
+extern template class BasicGateKeeper<
+    BasicWireKeeper<VectorArenaAllocatorPolicy<false>>>;
+
 } // namespace fbpcf::scheduler
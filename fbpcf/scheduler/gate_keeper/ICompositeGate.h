@@ -13,7 +13,6 @@
 
 #include "fbpcf/engine/ISecretShareEngine.h"
 #include "fbpcf/scheduler/IScheduler.h"
-#include "fbpcf/scheduler/IWireKeeper.h"
 #include "fbpcf/scheduler/gate_keeper/IGate.h"
 
 namespace fbpcf::scheduler {
@@ -35,25 +34,23 @@ class ICompositeGate : public IGate {
       std::vector<IScheduler::WireId<IScheduler::Boolean>> outputWireIDs,
       IScheduler::WireId<IScheduler::Boolean> left,
       std::vector<IScheduler::WireId<IScheduler::Boolean>> rights,
-      uint32_t numberOfResults,
-      IWireKeeper& wireKeeper)
+      uint32_t numberOfResults)
       : gateType_{gateType},
         outputWireIDs_{outputWireIDs},
         left_{left},
         rights_{rights},
-        numberOfResults_{numberOfResults},
-        wireKeeper_{wireKeeper} {
+        numberOfResults_{numberOfResults} {
     if (outputWireIDs.size() != rights.size()) {
       throw std::runtime_error(
           "Number of input wires on rhs must equal number of output wires.");
     }
   }
 
-  ICompositeGate(const ICompositeGate& g) : wireKeeper_(g.wireKeeper_) {
+  ICompositeGate(const ICompositeGate& g) {
     copy(g);
   }
 
-  ICompositeGate(ICompositeGate&& g) noexcept : wireKeeper_(g.wireKeeper_) {
+  ICompositeGate(ICompositeGate&& g) noexcept {
     move(std::move(g));
   }
 
@@ -107,7 +104,6 @@ class ICompositeGate : public IGate {
   std::vector<IScheduler::WireId<IScheduler::Boolean>> rights_;
   uint32_t scheduledResultIndex_;
   uint32_t numberOfResults_;
-  IWireKeeper& wireKeeper_;
 
   void copy(const ICompositeGate& src) {
     for (auto wireID : outputWireIDs_) {
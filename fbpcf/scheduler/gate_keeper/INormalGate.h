@@ -11,7 +11,6 @@
 
 #include "fbpcf/engine/ISecretShareEngine.h"
 #include "fbpcf/scheduler/IScheduler.h"
-#include "fbpcf/scheduler/IWireKeeper.h"
 #include "fbpcf/scheduler/gate_keeper/IGate.h"
 
 namespace fbpcf::scheduler {
@@ -40,21 +39,19 @@ class INormalGate : public IGate {
       IScheduler::WireId<T> left,
       IScheduler::WireId<T> right,
       int partyID,
-      uint32_t numberOfResults,
-      IWireKeeper& wireKeeper)
+      uint32_t numberOfResults)
       : gateType_{gateType},
         wireID_{wireID},
         left_{left},
         right_{right},
         partyID_{partyID},
-        numberOfResults_{numberOfResults},
-        wireKeeper_{wireKeeper} {}
+        numberOfResults_{numberOfResults} {}
 
-  INormalGate(const INormalGate& g) : wireKeeper_(g.wireKeeper_) {
+  INormalGate(const INormalGate& g) {
     copy(g);
   }
 
-  INormalGate(INormalGate&& g) noexcept : wireKeeper_(g.wireKeeper_) {
+  INormalGate(INormalGate&& g) noexcept {
     move(std::move(g));
   }
 
@@ -101,7 +98,6 @@ class INormalGate : public IGate {
   int partyID_;
   uint32_t scheduledResultIndex_;
   uint32_t numberOfResults_;
-  IWireKeeper& wireKeeper_;
 
   void copy(const INormalGate<T>& src) {
     decreaseReferenceCount(wireID_);
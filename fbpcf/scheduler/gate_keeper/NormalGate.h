@@ -9,11 +9,12 @@
 
 #include <map>
 
+#include "fbpcf/scheduler/IWireKeeper.h"
 #include "fbpcf/scheduler/gate_keeper/INormalGate.h"
 
 namespace fbpcf::scheduler {
 
-template <IScheduler::WireType T>
+template <IScheduler::WireType T, typename WireKeeperT = IWireKeeper>
 class NormalGate final : public INormalGate<T> {
   using typename INormalGate<T>::GateType;
   using INormalGate<T>::gateType_;
@@ -23,7 +24,6 @@ class NormalGate final : public INormalGate<T> {
   using INormalGate<T>::partyID_;
   using INormalGate<T>::scheduledResultIndex_;
   using INormalGate<T>::numberOfResults_;
-  using INormalGate<T>::wireKeeper_;
 
  public:
   NormalGate(
@@ -32,15 +32,15 @@ class NormalGate final : public INormalGate<T> {
       IScheduler::WireId<T> left,
       IScheduler::WireId<T> right,
       int partyID,
-      IWireKeeper& wireKeeper)
+      WireKeeperT& wireKeeper)
       : INormalGate<T>{
             gateType,
             wireID,
             left,
             right,
             partyID,
-            /*numberOfResults*/ 1,
-            wireKeeper} {
+            /*numberOfResults*/ 1},
+        wireKeeper_{wireKeeper} {
     increaseReferenceCount(wireID_);
     increaseReferenceCount(left_);
     increaseReferenceCount(right_);
@@ -146,6 +146,9 @@ class NormalGate final : public INormalGate<T> {
       wireKeeper_.decreaseReferenceCount(wire);
     }
   }
+
+ private:
+  WireKeeperT& wireKeeper_;
 };
 
 } // namespace fbpcf::scheduler
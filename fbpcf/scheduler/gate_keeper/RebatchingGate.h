@@ -8,9 +8,9 @@
 #pragma once
 
 #include <cstddef>
-#include <functional>
 #include <stdexcept>
 #include <string>
+#include <vector>
 #include "fbpcf/scheduler/gate_keeper/INormalGate.h"
 
 namespace fbpcf::scheduler {
@@ -92,38 +92,26 @@ class RebatchingBooleanGate : public IGate {
   }
 
  private:
+  // The output wires become views of the input wires, no values are copied.
   void executeBatchingGate() const {
-    size_t batchIndex = 0;
-    size_t totalSize = 0;
-    std::vector<std::reference_wrapper<const std::vector<bool>>> batchValues(
-        individualWireIDs_.size(),
-        wireKeeper_.getBatchBooleanValue(individualWireIDs_.at(0)));
-
-    for (size_t i = 0; i < individualWireIDs_.size(); i++) {
-      batchValues[i] =
-          wireKeeper_.getBatchBooleanValue(individualWireIDs_.at(i));
-      totalSize += batchValues.at(i).get().size();
-    }
-
-    std::vector<bool> dst(totalSize);
-
+    std::vector<IWireKeeper::BatchSlice> slices(individualWireIDs_.size());
     for (size_t i = 0; i < individualWireIDs_.size(); i++) {
-      for (size_t j = 0; j < batchValues.at(i).get().size(); j++) {
-        dst[batchIndex++] = batchValues.at(i).get().at(j);
-      }
+      slices[i] = IWireKeeper::BatchSlice{
+          individualWireIDs_.at(i),
+          0,
+          wireKeeper_.getBatchBooleanSize(individualWireIDs_.at(i))};
     }
-    wireKeeper_.setBatchBooleanValue(batchWireID_, dst);
+    wireKeeper_.setBatchBooleanView(batchWireID_, slices);
   }
 
   void executeUnbatchingGate() const {
     size_t batchIndex = 0;
-    auto& src = wireKeeper_.getBatchBooleanValue(batchWireID_);
     for (size_t i = 0; i < unbatchingStrategy_->size(); i++) {
-      std::vector<bool> dst(unbatchingStrategy_->at(i));
-      for (size_t j = 0; j < dst.size(); j++) {
-        dst[j] = src.at(batchIndex++);
-      }
-      wireKeeper_.setBatchBooleanValue(individualWireIDs_.at(i), dst);
+      wireKeeper_.setBatchBooleanView(
+          individualWireIDs_.at(i),
+          {IWireKeeper::BatchSlice{
+              batchWireID_, batchIndex, unbatchingStrategy_->at(i)}});
+      batchIndex += unbatchingStrategy_->at(i);
     }
   }
 
@@ -81,10 +81,9 @@ void testLevel(
   }
 }
 
-TEST(GateKeeperTest, TestAddAndRemoveGates) {
-  std::shared_ptr<IWireKeeper> wireKeeper =
-      WireKeeper::createWithVectorArena<unsafe>();
-  auto gateKeeper = std::make_unique<GateKeeper>(wireKeeper);
+template <typename WireKeeperT>
+void testAddAndRemoveGates(std::shared_ptr<WireKeeperT> wireKeeper) {
+  auto gateKeeper = std::make_unique<BasicGateKeeper<WireKeeperT>>(wireKeeper);
 
   // Non-batching API
 
@@ -178,10 +177,19 @@ TEST(GateKeeperTest, TestAddAndRemoveGates) {
   EXPECT_EQ(gateKeeper->getFirstUnexecutedLevel(), 12);
 }
 
-TEST(GateKeeperTest, TestCompositeGates) {
-  std::shared_ptr<IWireKeeper> wireKeeper =
-      WireKeeper::createWithVectorArena<unsafe>();
-  auto gateKeeper = std::make_unique<GateKeeper>(wireKeeper);
+TEST(GateKeeperTest, TestAddAndRemoveGates) {
+  testAddAndRemoveGates<IWireKeeper>(
+      WireKeeper::createWithVectorArena<unsafe>());
+}
+
+TEST(GateKeeperTest, TestAddAndRemoveGatesWithInlinedVectorArena) {
+  testAddAndRemoveGates<BasicWireKeeper<VectorArenaAllocatorPolicy<unsafe>>>(
+      WireKeeper::createWithInlinedVectorArena<unsafe>());
+}
+
+template <typename WireKeeperT>
+void testCompositeGates(std::shared_ptr<WireKeeperT> wireKeeper) {
+  auto gateKeeper = std::make_unique<BasicGateKeeper<WireKeeperT>>(wireKeeper);
 
   // level 0
   auto leftWire = gateKeeper->inputGate(true);
@@ -256,4 +264,13 @@ TEST(GateKeeperTest, TestCompositeGates) {
   testLevel(gateKeeper->popFirstUnexecutedLevel(), {}, {wires4}, {});
 }
 
+TEST(GateKeeperTest, TestCompositeGates) {
+  testCompositeGates<IWireKeeper>(WireKeeper::createWithVectorArena<unsafe>());
+}
+
+TEST(GateKeeperTest, TestCompositeGatesWithInlinedVectorArena) {
+  testCompositeGates<BasicWireKeeper<VectorArenaAllocatorPolicy<unsafe>>>(
+      WireKeeper::createWithInlinedVectorArena<unsafe>());
+}
+
 } // namespace fbpcf::scheduler
@@ -8,6 +8,7 @@
 #include <gtest/gtest.h>
 
 #include "fbpcf/scheduler/IAllocator.h"
+#include "fbpcf/scheduler/PagedArenaAllocator.h"
 #include "fbpcf/scheduler/UnorderedMapAllocator.h"
 #include "fbpcf/scheduler/VectorArenaAllocator.h"
 
@@ -50,6 +51,57 @@ TEST(SafeVectorArenaAllocatorTest, testAllocator) {
       std::make_unique<VectorArenaAllocator<int64_t, /*unsafe*/ false>>());
 }
 
+TEST(UnsafePagedArenaAllocatorTest, testAllocator) {
+  testAllocator<int64_t>(
+      std::make_unique<PagedArenaAllocator<int64_t, /*unsafe*/ true>>());
+}
+
+TEST(SafePagedArenaAllocatorTest, testAllocator) {
+  testAllocator<int64_t>(
+      std::make_unique<PagedArenaAllocator<int64_t, /*unsafe*/ false>>());
+}
+
+template <bool unsafe>
+void testPagedArenaGrowth() {
+  PagedArenaAllocator<int64_t, unsafe> arena;
+  auto outside = arena.allocate(-1);
+
+  std::vector<uint64_t> ids;
+  for (auto i = 0; i < 3000; ++i) {
+    ids.push_back(arena.allocate(i));
+  }
+  // pages grow geometrically: 1024 + 2048
+  EXPECT_EQ(arena.getCapacity(), 3072);
+  for (auto i = 0; i < 3000; ++i) {
+    EXPECT_EQ(arena.get(ids.at(i)), i);
+  }
+  for (auto id : ids) {
+    arena.free(id);
+  }
+
+  EXPECT_EQ(arena.get(outside), -1);
+  if (arena.isSafe()) {
+    EXPECT_THROW(arena.get(ids.at(0)), std::runtime_error);
+    EXPECT_THROW(arena.get(ids.at(2999)), std::runtime_error);
+    EXPECT_THROW(arena.free(ids.at(0)), std::runtime_error);
+  }
+
+  // all freed slots are available again without growing the arena
+  for (auto i = 0; i < 3000; ++i) {
+    auto id = arena.allocate(i);
+    EXPECT_EQ(arena.get(id), i);
+  }
+  EXPECT_EQ(arena.getCapacity(), 3072);
+}
+
+TEST(UnsafePagedArenaAllocatorTest, testGrowth) {
+  testPagedArenaGrowth</*unsafe*/ true>();
+}
+
+TEST(SafePagedArenaAllocatorTest, testGrowth) {
+  testPagedArenaGrowth</*unsafe*/ false>();
+}
+
 TEST(UnorderedMapAllocatorTest, testAllocator) {
   testAllocator<int64_t>(std::make_unique<UnorderedMapAllocator<int64_t>>());
 }
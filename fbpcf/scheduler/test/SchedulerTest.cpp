@@ -24,10 +24,9 @@ const bool unsafe = false;
 const int numberOfParties = 2;
 
 void runWithScheduler(
-    SchedulerType schedulerType,
+    SchedulerCreator schedulerCreator,
     std::function<void(std::unique_ptr<IScheduler> scheduler, int8_t myID)>
         testBody) {
-  auto schedulerCreator = getSchedulerCreator<unsafe>(schedulerType);
   auto agentFactories =
       engine::communication::getInMemoryAgentFactory(numberOfParties);
 
@@ -51,6 +50,13 @@ void runWithScheduler(
   }
 }
 
+void runWithScheduler(
+    SchedulerType schedulerType,
+    std::function<void(std::unique_ptr<IScheduler> scheduler, int8_t myID)>
+        testBody) {
+  runWithScheduler(getSchedulerCreator<unsafe>(schedulerType), testBody);
+}
+
 class SchedulerTestFixture : public ::testing::TestWithParam<SchedulerType> {};
 
 INSTANTIATE_TEST_SUITE_P(
@@ -515,6 +521,18 @@ TEST_P(SchedulerTestFixture, testBatchingAndUnbatching) {
   runWithScheduler(GetParam(), testBatchingAndUnbatching);
 }
 
+// the lazy scheduler, its gate keeper and its gates call this wire keeper by
+// its concrete type.
+TEST(SchedulerTest, testLazySchedulerWithInlinedVectorArena) {
+  SchedulerCreator schedulerCreator = createLazySchedulerWithInsecureEngine<
+      unsafe,
+      WireKeeperType::InlinedVectorArena>;
+  runWithScheduler(schedulerCreator, testMultipleOperations);
+  runWithScheduler(schedulerCreator, testReferenceCount);
+  runWithScheduler(schedulerCreator, testReferenceCountBatch);
+  runWithScheduler(schedulerCreator, testBatchingAndUnbatching);
+}
+
 class CompositeSchedulerTestFixture
     : public ::testing::TestWithParam<std::tuple<SchedulerType, size_t>> {};
 
@@ -78,6 +78,69 @@ TEST(SafeVectorArenaWireKeeperTest, testAllocateSetAndGet) {
       WireKeeper::createWithVectorArena</*unsafe*/ false>());
 }
 
+TEST(UnsafeInlinedVectorArenaWireKeeperTest, testAllocateSetAndGet) {
+  wireKeeperTestAllocateSetAndGet(
+      WireKeeper::createWithInlinedVectorArena</*unsafe*/ true>());
+}
+
+TEST(SafeInlinedVectorArenaWireKeeperTest, testAllocateSetAndGet) {
+  wireKeeperTestAllocateSetAndGet(
+      WireKeeper::createWithInlinedVectorArena</*unsafe*/ false>());
+}
+
+TEST(SafePagedArenaWireKeeperTest, testAllocateSetAndGet) {
+  wireKeeperTestAllocateSetAndGet(
+      WireKeeper::createWithPagedArena</*unsafe*/ false>());
+}
+
+void wireKeeperTestRecycleBatchBuffers(
+    std::unique_ptr<IWireKeeper> wireKeeper) {
+  std::vector<bool> testValue1(1000, true);
+  auto wire1 = wireKeeper->allocateBatchBooleanValue(std::move(testValue1));
+  auto capacity = wireKeeper->getBatchBooleanValue(wire1).capacity();
+  testVectorEq(
+      wireKeeper->getBatchBooleanValue(wire1), std::vector<bool>(1000, true));
+  wireKeeper->decreaseBatchReferenceCount(wire1);
+
+  // A similarly sized batch reuses the freed buffer and doesn't see its data.
+  std::vector<bool> testValue2(600, false);
+  testValue2[3] = true;
+  auto wire2 = wireKeeper->allocateBatchBooleanValue(testValue2);
+  testVectorEq(wireKeeper->getBatchBooleanValue(wire2), testValue2);
+  EXPECT_EQ(wireKeeper->getBatchBooleanValue(wire2).capacity(), capacity);
+
+  // A much smaller batch doesn't take a large buffer.
+  wireKeeper->decreaseBatchReferenceCount(wire2);
+  std::vector<bool> testValue3(3, true);
+  auto wire3 = wireKeeper->allocateBatchBooleanValue(testValue3);
+  testVectorEq(wireKeeper->getBatchBooleanValue(wire3), testValue3);
+  EXPECT_LT(wireKeeper->getBatchBooleanValue(wire3).capacity(), capacity);
+}
+
+TEST(UnorderedMapWireKeeperTest, testRecycleBatchBuffers) {
+  wireKeeperTestRecycleBatchBuffers(WireKeeper::createWithUnorderedMap());
+}
+
+TEST(UnsafeVectorArenaWireKeeperTest, testRecycleBatchBuffers) {
+  wireKeeperTestRecycleBatchBuffers(
+      WireKeeper::createWithVectorArena</*unsafe*/ true>());
+}
+
+TEST(SafeVectorArenaWireKeeperTest, testRecycleBatchBuffers) {
+  wireKeeperTestRecycleBatchBuffers(
+      WireKeeper::createWithVectorArena</*unsafe*/ false>());
+}
+
+TEST(UnsafeInlinedVectorArenaWireKeeperTest, testRecycleBatchBuffers) {
+  wireKeeperTestRecycleBatchBuffers(
+      WireKeeper::createWithInlinedVectorArena</*unsafe*/ true>());
+}
+
+TEST(SafeInlinedVectorArenaWireKeeperTest, testRecycleBatchBuffers) {
+  wireKeeperTestRecycleBatchBuffers(
+      WireKeeper::createWithInlinedVectorArena</*unsafe*/ false>());
+}
+
 void wireKeeperTestAvailableLevel(std::unique_ptr<IWireKeeper> wireKeeper) {
   // Non batch API: Bool
   auto wire1 =
@@ -124,6 +187,21 @@ TEST(SafeVectorArenaWireKeeperTest, testAvailableLevel) {
       WireKeeper::createWithVectorArena</*unsafe*/ false>());
 }
 
+TEST(UnsafeInlinedVectorArenaWireKeeperTest, testAvailableLevel) {
+  wireKeeperTestAvailableLevel(
+      WireKeeper::createWithInlinedVectorArena</*unsafe*/ true>());
+}
+
+TEST(SafeInlinedVectorArenaWireKeeperTest, testAvailableLevel) {
+  wireKeeperTestAvailableLevel(
+      WireKeeper::createWithInlinedVectorArena</*unsafe*/ false>());
+}
+
+TEST(SafePagedArenaWireKeeperTest, testAvailableLevel) {
+  wireKeeperTestAvailableLevel(
+      WireKeeper::createWithPagedArena</*unsafe*/ false>());
+}
+
 void wireKeeperTestReferenceCount(std::unique_ptr<IWireKeeper> wireKeeper) {
   // Non batch API: Bool
   auto boolWire = wireKeeper->allocateBooleanValue(true);
@@ -255,4 +333,99 @@ TEST(SafeVectorArenaWireKeeperTest, testReferenceCount) {
   wireKeeperTestReferenceCount(
       WireKeeper::createWithVectorArena</*unsafe*/ false>());
 }
+
+TEST(SafeInlinedVectorArenaWireKeeperTest, testReferenceCount) {
+  wireKeeperTestReferenceCount(
+      WireKeeper::createWithInlinedVectorArena</*unsafe*/ false>());
+}
+
+TEST(SafePagedArenaWireKeeperTest, testReferenceCount) {
+  wireKeeperTestReferenceCount(
+      WireKeeper::createWithPagedArena</*unsafe*/ false>());
+}
+
+void wireKeeperTestBatchBooleanView(std::unique_ptr<IWireKeeper> wireKeeper) {
+  std::vector<bool> value1({true, false, true});
+  std::vector<bool> value2({false, false, true, true});
+  auto wire1 = wireKeeper->allocateBatchBooleanValue(value1);
+  auto wire2 = wireKeeper->allocateBatchBooleanValue(value2);
+
+  // concatenation
+  auto wire12 = wireKeeper->allocateBatchBooleanValue(std::vector<bool>());
+  wireKeeper->setBatchBooleanView(wire12, {{wire1, 0, 3}, {wire2, 0, 4}});
+  EXPECT_EQ(wireKeeper->getBatchBooleanSize(wire12), 7);
+
+  // slices of a view, resolved from the underlying wires
+  auto wire3 = wireKeeper->allocateBatchBooleanValue(std::vector<bool>());
+  auto wire4 = wireKeeper->allocateBatchBooleanValue(std::vector<bool>());
+  wireKeeper->setBatchBooleanView(wire3, {{wire12, 2, 3}});
+  wireKeeper->setBatchBooleanView(wire4, {{wire12, 5, 2}});
+
+  // the views keep their sources alive
+  wireKeeper->decreaseBatchReferenceCount(wire1);
+  wireKeeper->decreaseBatchReferenceCount(wire2);
+  wireKeeper->decreaseBatchReferenceCount(wire12);
+  testPairEq(wireKeeper->getWireStatistics(), {5, 0});
+
+  testVectorEq(
+      wireKeeper->getBatchBooleanValue(wire3),
+      std::vector<bool>({true, false, false}));
+  // a resolved view keeps its sources until it is overwritten or freed
+  testPairEq(wireKeeper->getWireStatistics(), {5, 0});
+  wireKeeper->getWritableBatchBooleanValue(wire4)[0] = false;
+  testPairEq(wireKeeper->getWireStatistics(), {5, 0});
+  testVectorEq(
+      wireKeeper->getBatchBooleanValue(wire4),
+      std::vector<bool>({false, true}));
+
+  // a view of one whole wire doesn't copy
+  auto wire5 = wireKeeper->allocateBatchBooleanValue(std::vector<bool>());
+  wireKeeper->setBatchBooleanView(wire5, {{wire3, 0, 3}});
+  EXPECT_EQ(
+      &wireKeeper->getBatchBooleanValue(wire5),
+      &wireKeeper->getBatchBooleanValue(wire3));
+
+  // freeing a view releases its sources
+  wireKeeper->decreaseBatchReferenceCount(wire3);
+  wireKeeper->decreaseBatchReferenceCount(wire5);
+  testPairEq(wireKeeper->getWireStatistics(), {6, 2});
+
+  EXPECT_THROW(
+      wireKeeper->setBatchBooleanView(wire4, {{wire4, 1, 2}}),
+      std::runtime_error);
+
+  // so does overwriting it
+  wireKeeper->setBatchBooleanValue(wire4, {true});
+  testPairEq(wireKeeper->getWireStatistics(), {6, 5});
+  EXPECT_EQ(wireKeeper->getBatchBooleanSize(wire4), 1);
+}
+
+TEST(UnorderedMapWireKeeperTest, testBatchBooleanView) {
+  wireKeeperTestBatchBooleanView(WireKeeper::createWithUnorderedMap());
+}
+
+TEST(UnsafeVectorArenaWireKeeperTest, testBatchBooleanView) {
+  wireKeeperTestBatchBooleanView(
+      WireKeeper::createWithVectorArena</*unsafe*/ true>());
+}
+
+TEST(SafeVectorArenaWireKeeperTest, testBatchBooleanView) {
+  wireKeeperTestBatchBooleanView(
+      WireKeeper::createWithVectorArena</*unsafe*/ false>());
+}
+
+TEST(UnsafeInlinedVectorArenaWireKeeperTest, testBatchBooleanView) {
+  wireKeeperTestBatchBooleanView(
+      WireKeeper::createWithInlinedVectorArena</*unsafe*/ true>());
+}
+
+TEST(SafeInlinedVectorArenaWireKeeperTest, testBatchBooleanView) {
+  wireKeeperTestBatchBooleanView(
+      WireKeeper::createWithInlinedVectorArena</*unsafe*/ false>());
+}
+
+TEST(SafePagedArenaWireKeeperTest, testBatchBooleanView) {
+  wireKeeperTestBatchBooleanView(
+      WireKeeper::createWithPagedArena</*unsafe*/ false>());
+}
 } // namespace fbpcf::scheduler
@@ -9,6 +9,7 @@
 
 #include <folly/Benchmark.h>
 
+#include "fbpcf/scheduler/PagedArenaAllocator.h"
 #include "fbpcf/scheduler/UnorderedMapAllocator.h"
 #include "fbpcf/scheduler/VectorArenaAllocator.h"
 
@@ -53,4 +54,33 @@ inline void benchmarkGet(std::unique_ptr<IAllocator<T>> allocator, int n) {
   }
 }
 
+// Allocate n batch values, growing the allocator while it holds non-trivial
+// objects that would have to be moved on reallocation.
+template <typename T>
+inline void benchmarkAllocateBatch(
+    std::unique_ptr<IAllocator<std::vector<T>>> allocator,
+    int n) {
+  std::vector<T> value;
+  BENCHMARK_SUSPEND {
+    value = std::vector<T>(64);
+  }
+  while (n--) {
+    allocator->allocate(std::vector<T>(value));
+  }
+}
+
+// Allocate n values and free them one by one.
+template <typename T>
+inline void benchmarkFreeIndividually(
+    std::unique_ptr<IAllocator<T>> allocator,
+    int n) {
+  std::vector<uint64_t> refs(n);
+  for (auto i = 0; i < n; i++) {
+    refs[i] = allocator->allocate(i);
+  }
+  for (auto ref : refs) {
+    allocator->free(ref);
+  }
+}
+
 } // namespace fbpcf::scheduler
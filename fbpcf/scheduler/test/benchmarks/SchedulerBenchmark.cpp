@@ -48,6 +48,41 @@ BENCHMARK(UnorderedMapAllocator_get, n) {
   benchmarkGet<int64_t>(std::make_unique<UnorderedMapAllocator<int64_t>>(), n);
 }
 
+BENCHMARK(PagedArenaAllocator_allocate, n) {
+  benchmarkAllocate<int64_t>(
+      std::make_unique<PagedArenaAllocator<int64_t, unsafe>>(), n);
+}
+
+BENCHMARK(PagedArenaAllocator_free, n) {
+  benchmarkFree<int64_t>(
+      std::make_unique<PagedArenaAllocator<int64_t, unsafe>>(), n);
+}
+
+BENCHMARK(PagedArenaAllocator_get, n) {
+  benchmarkGet<int64_t>(
+      std::make_unique<PagedArenaAllocator<int64_t, unsafe>>(), n);
+}
+
+BENCHMARK(VectorArenaAllocator_allocateBatch, n) {
+  benchmarkAllocateBatch<bool>(
+      std::make_unique<VectorArenaAllocator<std::vector<bool>, unsafe>>(), n);
+}
+
+BENCHMARK(PagedArenaAllocator_allocateBatch, n) {
+  benchmarkAllocateBatch<bool>(
+      std::make_unique<PagedArenaAllocator<std::vector<bool>, unsafe>>(), n);
+}
+
+BENCHMARK(VectorArenaAllocator_freeIndividually, n) {
+  benchmarkFreeIndividually<int64_t>(
+      std::make_unique<VectorArenaAllocator<int64_t, unsafe>>(), n);
+}
+
+BENCHMARK(PagedArenaAllocator_freeIndividually, n) {
+  benchmarkFreeIndividually<int64_t>(
+      std::make_unique<PagedArenaAllocator<int64_t, unsafe>>(), n);
+}
+
 // WireKeeper benchmarks
 
 BENCHMARK(WireKeeperBenchmark_allocateBooleanValue, n) {
@@ -92,6 +127,33 @@ BENCHMARK(WireKeeperBenchmark_decreaseReferenceCount, n) {
   }
 }
 
+BENCHMARK(InlinedVectorArenaWireKeeperBenchmark_increaseReferenceCount, n) {
+  BENCHMARK_INLINED_VECTOR_ARENA_WIREKEEPER {
+    wireKeeper->increaseReferenceCount(wireIds.at(n));
+  }
+}
+
+BENCHMARK(InlinedVectorArenaWireKeeperBenchmark_decreaseReferenceCount, n) {
+  BENCHMARK_INLINED_VECTOR_ARENA_WIREKEEPER {
+    wireKeeper->decreaseReferenceCount(wireIds.at(n));
+  }
+}
+
+BENCHMARK(WireKeeperBenchmark_setBatchBooleanView, n) {
+  folly::BenchmarkSuspender braces;
+  auto wireKeeper = WireKeeper::createWithVectorArena<unsafe>();
+  auto src = wireKeeper->allocateBatchBooleanValue(std::vector<bool>(10000));
+  std::vector<IScheduler::WireId<IScheduler::Boolean>> wireIds;
+  for (auto i = 0; i < n; i++) {
+    wireIds.push_back(
+        wireKeeper->allocateBatchBooleanValue(std::vector<bool>()));
+  }
+  braces.dismiss();
+  while (n--) {
+    wireKeeper->setBatchBooleanView(wireIds.at(n), {{src, 5000, 5000}});
+  }
+}
+
 // Scheduler benchmarks
 
 class SchedulerBenchmark : public engine::util::NetworkedBenchmark {
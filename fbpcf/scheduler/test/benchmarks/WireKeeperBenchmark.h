@@ -25,4 +25,14 @@ namespace fbpcf::scheduler {
   braces.dismiss();                                              \
   while (n--)
 
+#define BENCHMARK_INLINED_VECTOR_ARENA_WIREKEEPER                       \
+  folly::BenchmarkSuspender braces;                                     \
+  auto wireKeeper = WireKeeper::createWithInlinedVectorArena<unsafe>(); \
+  std::vector<IScheduler::WireId<IScheduler::Boolean>> wireIds;         \
+  for (auto i = 0; i < n; i++) {                                        \
+    wireIds.push_back(wireKeeper->allocateBooleanValue());              \
+  }                                                                     \
+  braces.dismiss();                                                     \
+  while (n--)
+
 } // namespace fbpcf::scheduler